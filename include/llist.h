@@ -23,6 +23,26 @@
 #ifndef LLIST_H
 #define LLIST_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+  /*
+   *  llist_config.h is written by configure; builds without it, such as the
+   *  windows recipe, get the default layout unless LLIST_NODE_KEY is given
+   */
+
+#ifndef LLIST_NODE_KEY
+#if defined __has_include
+#if __has_include("llist_config.h")
+#include "llist_config.h"
+#endif
+#endif
+#endif
+
+#ifndef LLIST_NODE_KEY
+#define LLIST_NODE_KEY 0
+#endif
+
   /**
    *  @typedef enum llist_position
    *  @brief used by llist_add() to determine insertion point
@@ -46,6 +66,10 @@ typedef struct llist_node llist_node;
   /**
    *  @struct llist_node
    *  @brief linked list node structure, contains forward, reverse and payload pointers
+   *
+   *  @a key is only present when built with --enable-node-key.  It sits
+   *  beside the links, in the same cache line, so that a scan can reject a
+   *  node without touching its payload, see <i> llist_set_key </i>.
    */
 
 struct llist_node
@@ -53,6 +77,9 @@ struct llist_node
   struct llist_node *previous;   /**<  points to previous node  */
   struct llist_node *next;       /**<  points to next node      */
   void *payload;                 /**<  generic node data        */
+#if LLIST_NODE_KEY
+  uint64_t key;                  /**<  cached key of payload    */
+#endif
 };
 
   /**
@@ -87,6 +114,64 @@ typedef void (*llist_free_node)(llist_node *node);
 
 typedef int (*llist_cmp_node)(llist_node *a, llist_node *b);
 
+  /**
+   *  @typedef uint64_t (*llist_key_node)(llist_node *node);
+   *  @brief   creates a type for function prototype to extract a 64 bit key,
+   *           a hash or a prefix of the compared fields, from the payload of
+   *           an @a llist_node struct
+   *
+   *  NOTE:  Two nodes that compare equal with the list @a llist_cmp_node
+   *         function MUST have the same key.
+   */
+
+typedef uint64_t (*llist_key_node)(llist_node *node);
+
+  /**
+   *  @typedef size_t (*llist_size_node)(llist_node *node);
+   *  @brief   creates a type for function prototype to report the size, in
+   *           bytes, of the payload of an @a llist_node struct
+   */
+
+typedef size_t (*llist_size_node)(llist_node *node);
+
+  /**
+   *  @typedef llist_node *(*llist_gen_node)(void *state);
+   *  @brief   creates a type for function prototype to generate the next
+   *           @a llist_node of a lazy list, NULL when there are no more
+   */
+
+typedef llist_node *(*llist_gen_node)(void *state);
+
+  /**
+   *  @typedef void (*llist_move_node)(llist_node *from, llist_node *to);
+   *  @brief   creates a type for function prototype to be notified that an
+   *           @a llist_node has moved from address @p from to address @p to
+   */
+
+typedef void (*llist_move_node)(llist_node *from, llist_node *to);
+
+  /**
+   *  @typedef llist_block
+   *  @brief creates a type for struct @a llist_block, private block of nodes
+   *         owned by an @a llist
+   */
+
+typedef struct llist_block llist_block;
+
+  /**
+   *  @typedef llist_view
+   *  @brief creates a type for struct @a llist_view, see llist_view.h
+   */
+
+typedef struct llist_view llist_view;
+
+  /**
+   *  @typedef llist_lru
+   *  @brief creates a type for struct @a llist_lru, see llist_lru.h
+   */
+
+typedef struct llist_lru llist_lru;
+
   /**
    *  @typedef llist
    *  @brief creates a type for struct @a llist
@@ -108,6 +193,40 @@ struct llist
   llist_dup_node dup_node;    /**<  user supplied function to duplicate a @a llist_node  */
   llist_free_node free_node;  /**<  user supplied function to free a @a llist_node  */
   llist_cmp_node cmp_node;    /**<  user supplied function to compare two @a llist_node structs  */
+  llist_key_node key_node;    /**<  user supplied function to extract the cached key of a @a llist_node  */
+  llist_gen_node gen_node;    /**<  user supplied function to generate the next @a llist_node, lazy lists only  */
+  void *gen_state;            /**<  user data passed to @a gen_node  */
+  int gen_ahead;              /**<  number of nodes generated at a time  */
+  llist_move_node move_node;  /**<  user supplied function notified when <i> llist_compact </i> moves a @a llist_node  */
+  llist_block *blocks;        /**<  blocks of nodes owned by the list, see <i> llist_compact </i>  */
+  llist_node *compact_next;   /**<  next @a llist_node to relocate  */
+  llist_block *compact_older; /**<  first block that predates the compaction in progress  */
+  int compacting;             /**<  non-zero while an incremental compaction is in progress  */
+  llist_node *unfreed;        /**<  relocated nodes removed, but not yet handed to @a free_node  */
+  llist_view *views;          /**<  views kept current with the list, see <i> llist_view_new </i>  */
+  llist_lru *lru;             /**<  cache whose recency list this is, see <i> llist_lru_new </i>  */
+  int pinned;                 /**<  non-zero if nodes MUST stay at their address, <i> llist_compact </i> refuses  */
+};
+
+  /**
+   *  @typedef llist_node_cache_stats
+   *  @brief creates a type for struct @a llist_node_cache_stats
+   */
+
+typedef struct llist_node_cache_stats llist_node_cache_stats;
+
+  /**
+   *  @struct llist_node_cache_stats
+   *  @brief node cache counters, see <i> llist_node_cache_stats_get </i>
+   */
+
+struct llist_node_cache_stats
+{
+  unsigned long allocs;       /**<  nodes requested by <i> llist_node_new </i>  */
+  unsigned long hits;         /**<  requests served from a node cache  */
+  unsigned long frees;        /**<  nodes passed to <i> llist_node_free </i>  */
+  unsigned long depot_gets;   /**<  full magazines taken from the global depot  */
+  unsigned long depot_puts;   /**<  full magazines handed to the global depot  */
 };
 
   /*
@@ -128,11 +247,21 @@ void llist_set_new(llist *ll, llist_new_node new_func);
 void llist_set_dup(llist *ll, llist_dup_node dup_func);
 void llist_set_free(llist *ll, llist_free_node free_func);
 void llist_set_cmp(llist *ll, llist_cmp_node cmp_func);
+void llist_set_key(llist *ll, llist_key_node key_func);
+void llist_set_gen(llist *ll,
+                   llist_gen_node gen_func,
+                   void *state,
+                   int read_ahead);
+void llist_set_move(llist *ll, llist_move_node move_func);
+int llist_compact(llist *ll, long budget);
 void llist_add(llist *ll,
                llist_position position,
                llist_node *where,
                llist_node *node);
 void llist_remove(llist *ll, llist_node *node);
+void llist_unlink(llist *ll, llist_node *node);
+void llist_release(llist *ll, llist_node *node);
+void llist_sort(llist *ll);
 llist_node *llist_head(llist *ll);
 llist_node *llist_tail(llist *ll);
 llist_node *llist_current(llist *ll);
@@ -146,5 +275,8 @@ llist_node *llist_find_payload(llist *ll, void *payload);
    */
 
 llist_node *llist_node_new(void *payload);
+void llist_node_free(llist_node *node);
+void llist_node_cache_stats_get(llist_node_cache_stats *stats);
+void llist_node_cache_purge(void);
 
 #endif //LLIST_H
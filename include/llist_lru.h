@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_lru.h
+ *  @brief Header file for least recently used cache built on @a llist
+ */
+
+#ifndef LLIST_LRU_H
+#define LLIST_LRU_H
+
+#include <stddef.h>
+
+#include "llist.h"
+
+  /**
+   *  @typedef unsigned long (*llist_hash_node)(llist_node *node);
+   *  @brief   creates a type for function prototype to hash the key of an
+   *           @a llist_node struct
+   *
+   *  NOTE:  Two nodes that compare equal with the list @a llist_cmp_node
+   *         function MUST hash to the same value.
+   */
+
+typedef unsigned long (*llist_hash_node)(llist_node *node);
+
+  /**
+   *  @typedef llist_lru_entry
+   *  @brief creates a type for struct @a llist_lru_entry, private hash table
+   *         entry of an @a llist_lru
+   */
+
+typedef struct llist_lru_entry llist_lru_entry;
+
+  /**
+   *  @struct llist_lru
+   *  @brief LLIST_LRU structure, contains metadata for a least recently used
+   *         cache
+   *
+   *  The cached nodes live in @a ll, ordered from most recently used (head) to
+   *  least recently used (tail).  The @a llist_set_dup(), @a llist_set_free()
+   *  and @a llist_set_cmp() functions should be called on @a ll, exactly as
+   *  for any other @a llist.
+   */
+
+struct llist_lru
+{
+  llist *ll;                    /**<  recency ordered list of cached nodes  */
+  llist_lru_entry **buckets;    /**<  hash table of cached nodes  */
+  size_t nbuckets;              /**<  number of hash table buckets  */
+  size_t count;                 /**<  number of cached nodes  */
+  size_t bytes;                 /**<  bytes charged to cached nodes  */
+  size_t max_count;             /**<  node capacity, 0 for no limit  */
+  size_t max_bytes;             /**<  byte capacity, 0 for no limit  */
+  llist_hash_node hash_node;    /**<  user supplied function to hash a @a llist_node  */
+  llist_size_node size_node;    /**<  user supplied function to size a @a llist_node  */
+  llist_free_node evict_node;   /**<  user supplied function called on evicted @a llist_node  */
+  unsigned long hits;           /**<  number of successful <i> llist_lru_get </i> calls  */
+  unsigned long misses;         /**<  number of failed <i> llist_lru_get </i> calls  */
+  unsigned long evictions;      /**<  number of nodes evicted to honor capacity  */
+};
+
+  /*
+   *  LLIST_LRU functions
+   */
+
+llist_lru *llist_lru_new(size_t max_count, size_t max_bytes);
+void llist_lru_free(llist_lru *lru);
+void llist_lru_set_hash(llist_lru *lru, llist_hash_node hash_func);
+void llist_lru_set_size(llist_lru *lru, llist_size_node size_func);
+void llist_lru_set_evict(llist_lru *lru, llist_free_node evict_func);
+llist_node *llist_lru_get(llist_lru *lru, llist_node *needle);
+llist_node *llist_lru_put(llist_lru *lru, llist_node *node);
+void llist_lru_touch(llist_lru *lru, llist_node *node);
+void llist_lru_remove(llist_lru *lru, llist_node *node);
+int llist_lru_evict(llist_lru *lru);
+
+#endif //LLIST_LRU_H
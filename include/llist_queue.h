@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_queue.h
+ *  @brief Header file for bounded, blocking producer/consumer queue built on
+ *         @a llist
+ */
+
+#ifndef LLIST_QUEUE_H
+#define LLIST_QUEUE_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+#include "llist.h"
+
+  /**
+   *  @typedef llist_queue
+   *  @brief creates a type for struct @a llist_queue
+   */
+
+typedef struct llist_queue llist_queue;
+
+  /**
+   *  @struct llist_queue
+   *  @brief LLIST_QUEUE structure, contains metadata for a bounded, thread
+   *         safe first in, first out queue
+   *
+   *  Nodes are pushed at the tail and popped from the head of @a ll.  The
+   *  @a llist_set_free() function may be called on @a ll, it is used for
+   *  nodes still queued when the queue is freed.
+   */
+
+struct llist_queue
+{
+  llist *ll;                    /**<  queued nodes, oldest at head  */
+  size_t count;                 /**<  number of queued nodes  */
+  size_t capacity;              /**<  maximum number of queued nodes, 0 for no limit  */
+  int closed;                   /**<  non-zero once <i> llist_queue_close </i> is called  */
+  int efd;                      /**<  eventfd signalled when the queue becomes non-empty, -1 if none  */
+  pthread_mutex_t lock;         /**<  protects all of the above  */
+  pthread_cond_t not_empty;     /**<  signalled when a node is pushed  */
+  pthread_cond_t not_full;      /**<  signalled when a node is popped  */
+};
+
+  /*
+   *  LLIST_QUEUE functions
+   */
+
+llist_queue *llist_queue_new(size_t capacity);
+void llist_queue_free(llist_queue *q);
+int llist_queue_eventfd(llist_queue *q);
+void llist_queue_close(llist_queue *q);
+int llist_queue_push(llist_queue *q, llist_node *node, long timeout);
+llist_node *llist_queue_pop(llist_queue *q, long timeout);
+size_t llist_queue_pop_batch(llist_queue *q,
+                             llist *batch,
+                             size_t max,
+                             long timeout);
+
+#endif //LLIST_QUEUE_H
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_shm.h
+ *  @brief Header file for process shared doubly linked lists, kept in a
+ *         shared memory segment
+ */
+
+#ifndef LLIST_SHM_H
+#define LLIST_SHM_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+#include "llist.h"
+
+#define LLIST_SHM_MAGIC 0x6c6c7368    /**<  "llsh", marks an initialized segment  */
+#define LLIST_SHM_CLASSES 48          /**<  number of allocator size classes  */
+
+  /**
+   *  @typedef llist_shm_off
+   *  @brief offset from the start of a segment, 0 stands for NULL
+   *
+   *  Every process maps the segment at its own address, so links between
+   *  shared nodes are stored as offsets rather than pointers.
+   */
+
+typedef size_t llist_shm_off;
+
+  /**
+   *  @typedef llist_shm_node
+   *  @brief creates a type for struct @a llist_shm_node
+   */
+
+typedef struct llist_shm_node llist_shm_node;
+
+  /**
+   *  @struct llist_shm_node
+   *  @brief shared linked list node, the payload bytes follow the struct
+   */
+
+struct llist_shm_node
+{
+  llist_shm_off previous;   /**<  offset of previous node  */
+  llist_shm_off next;       /**<  offset of next node  */
+  size_t size;              /**<  payload size in bytes  */
+};
+
+  /**
+   *  @typedef llist_shm_header
+   *  @brief creates a type for struct @a llist_shm_header
+   */
+
+typedef struct llist_shm_header llist_shm_header;
+
+  /**
+   *  @struct llist_shm_header
+   *  @brief list metadata, at the start of the shared memory segment
+   */
+
+struct llist_shm_header
+{
+  unsigned int magic;                           /**<  LLIST_SHM_MAGIC once initialized  */
+  size_t size;                                  /**<  segment size in bytes  */
+  pthread_rwlock_t lock;                        /**<  process shared list lock  */
+  llist_shm_off head;                           /**<  offset of head node  */
+  llist_shm_off tail;                           /**<  offset of tail node  */
+  size_t count;                                 /**<  number of nodes  */
+  llist_shm_off brk;                            /**<  start of never allocated space  */
+  llist_shm_off free_blocks[LLIST_SHM_CLASSES]; /**<  freed blocks, by size class  */
+};
+
+  /**
+   *  @typedef llist_shm
+   *  @brief creates a type for struct @a llist_shm
+   */
+
+typedef struct llist_shm llist_shm;
+
+  /**
+   *  @struct llist_shm
+   *  @brief per process handle of a shared list
+   */
+
+struct llist_shm
+{
+  llist_shm_header *header;   /**<  segment, as mapped in this process  */
+  size_t size;                /**<  mapped size in bytes  */
+  int fd;                     /**<  segment file descriptor  */
+};
+
+  /*
+   *  LLIST_SHM functions
+   */
+
+llist_shm *llist_shm_create(const char *name, size_t size);
+llist_shm *llist_shm_open(const char *name);
+llist_shm *llist_shm_attach(int fd);
+void llist_shm_close(llist_shm *shm);
+int llist_shm_unlink(const char *name);
+void llist_shm_lock(llist_shm *shm, int write);
+void llist_shm_unlock(llist_shm *shm);
+llist_shm_node *llist_shm_add(llist_shm *shm,
+                              llist_position position,
+                              llist_shm_node *where,
+                              const void *payload,
+                              size_t size);
+llist_shm_node *llist_shm_add_locked(llist_shm *shm,
+                                     llist_position position,
+                                     llist_shm_node *where,
+                                     const void *payload,
+                                     size_t size);
+void llist_shm_remove(llist_shm *shm, llist_shm_node *node);
+void llist_shm_remove_locked(llist_shm *shm, llist_shm_node *node);
+int llist_shm_import(llist_shm *shm, llist *ll, llist_size_node size_func);
+llist_shm_node *llist_shm_head(llist_shm *shm);
+llist_shm_node *llist_shm_tail(llist_shm *shm);
+llist_shm_node *llist_shm_previous(llist_shm *shm, llist_shm_node *node);
+llist_shm_node *llist_shm_next(llist_shm *shm, llist_shm_node *node);
+llist_shm_node *llist_shm_find(llist_shm *shm,
+                               llist_node *needle,
+                               llist_cmp_node cmp_func);
+void *llist_shm_payload(llist_shm_node *node);
+
+#endif //LLIST_SHM_H
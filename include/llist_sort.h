@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_sort.h
+ *  @brief Header file for external memory sorting of @a llist lists
+ */
+
+#ifndef LLIST_SORT_H
+#define LLIST_SORT_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "llist.h"
+
+#define LLIST_SORT_FAN_IN 64    /**<  default number of runs merged at once  */
+
+  /**
+   *  @typedef int (*llist_write_node)(FILE *fp, llist_node *node);
+   *  @brief   creates a type for function prototype to serialize an
+   *           @a llist_node struct to @p fp, returning 0 on success
+   */
+
+typedef int (*llist_write_node)(FILE *fp, llist_node *node);
+
+  /**
+   *  @typedef llist_node *(*llist_read_node)(FILE *fp);
+   *  @brief   creates a type for function prototype to deserialize the next
+   *           @a llist_node struct from @p fp, NULL on failure
+   *
+   *  NOTE:  It is called exactly once per node written, never past the end
+   *         of a run, so a NULL return is always treated as an error.
+   *
+   *  NOTE:  The node and its payload are allocated as for @a llist_dup_node,
+   *         and are later freed by the list free node function.
+   */
+
+typedef llist_node *(*llist_read_node)(FILE *fp);
+
+  /**
+   *  @typedef int (*llist_sink_node)(llist_node *node, void *state);
+   *  @brief   creates a type for function prototype to consume the next
+   *           sorted @a llist_node, returning non-zero to stop
+   *
+   *  NOTE:  The function owns @p node after the call.
+   */
+
+typedef int (*llist_sink_node)(llist_node *node, void *state);
+
+  /**
+   *  @typedef llist_sort_config
+   *  @brief creates a type for struct @a llist_sort_config
+   */
+
+typedef struct llist_sort_config llist_sort_config;
+
+  /**
+   *  @struct llist_sort_config
+   *  @brief settings for <i> llist_sort_external </i>
+   *
+   *  Only @a write_node and @a read_node are required, unset fields take
+   *  their defaults.
+   */
+
+struct llist_sort_config
+{
+  llist_write_node write_node;  /**<  user supplied function to spill a @a llist_node  */
+  llist_read_node read_node;    /**<  user supplied function to read back a @a llist_node  */
+  llist_size_node size_node;    /**<  user supplied function to size a payload, optional  */
+  size_t budget;                /**<  bytes of nodes held in memory, 0 for no limit  */
+  int fan_in;                   /**<  runs merged at once, 0 for LLIST_SORT_FAN_IN  */
+  int unique;                   /**<  non-zero to keep only the first of equal nodes  */
+  const char *tmpdir;           /**<  directory for run files, NULL for tmpfile()  */
+  llist_sink_node sink_node;    /**<  user supplied function to consume sorted nodes, optional  */
+  void *sink_state;             /**<  user data passed to @a sink_node  */
+};
+
+  /*
+   *  LLIST_SORT functions
+   */
+
+int llist_sort_external(llist *ll, llist_sort_config *config);
+
+#endif //LLIST_SORT_H
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_view.h
+ *  @brief Header file for filtered and sorted views of an @a llist, kept
+ *         current as the list changes
+ */
+
+#ifndef LLIST_VIEW_H
+#define LLIST_VIEW_H
+
+#include <stddef.h>
+
+#include "llist.h"
+
+#define LLIST_VIEW_LEVELS 24    /**<  maximum skip list height of a sorted view  */
+
+  /**
+   *  @typedef int (*llist_filter_node)(llist_node *node);
+   *  @brief   creates a type for function prototype to decide whether an
+   *           @a llist_node belongs in a view, non-zero if it does
+   */
+
+typedef int (*llist_filter_node)(llist_node *node);
+
+  /**
+   *  @typedef llist_view_entry
+   *  @brief creates a type for struct @a llist_view_entry, private shadow
+   *         node of an @a llist_view
+   */
+
+typedef struct llist_view_entry llist_view_entry;
+
+  /**
+   *  @struct llist_view
+   *  @brief LLIST_VIEW structure, contains metadata for a view of an @a llist
+   *
+   *  The view's nodes live in @a ll, and are traversed with
+   *  <i> llist_head </i>, <i> llist_next </i> and friends as for any other
+   *  @a llist.  Each shares its payload with a node of @a base, found with
+   *  <i> llist_view_base </i>.  @a ll is kept current by the @a base list
+   *  functions, and MUST NOT be modified by the caller.
+   */
+
+struct llist_view
+{
+  llist *ll;                                  /**<  nodes in the view, in view order  */
+  llist *base;                                /**<  list viewed, NULL once freed  */
+  llist_filter_node filter_node;              /**<  user supplied function to select nodes, NULL for all  */
+  llist_cmp_node cmp_node;                    /**<  user supplied function to order nodes, NULL for base order  */
+  llist_view_entry **buckets;                 /**<  hash table of shadow nodes, by base node  */
+  size_t nbuckets;                            /**<  number of hash table buckets  */
+  size_t count;                               /**<  number of nodes in the view  */
+  llist_view_entry *skip[LLIST_VIEW_LEVELS];  /**<  skip list heads, sorted views only  */
+  int levels;                                 /**<  skip list levels in use  */
+  unsigned long seq;                          /**<  insertion counter, orders equal nodes  */
+  unsigned int random;                        /**<  skip list level generator state  */
+  llist_view *next;                           /**<  next view of @a base  */
+};
+
+  /*
+   *  LLIST_VIEW functions
+   */
+
+llist_view *llist_view_new(llist *base,
+                           llist_filter_node filter_func,
+                           llist_cmp_node cmp_func);
+void llist_view_free(llist_view *view);
+void llist_view_refresh(llist *base, llist_node *node);
+llist_node *llist_view_base(llist_node *node);
+
+#endif //LLIST_VIEW_H
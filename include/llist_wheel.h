@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_wheel.h
+ *  @brief Header file for hierarchical timing wheel built on @a llist buckets
+ */
+
+#ifndef LLIST_WHEEL_H
+#define LLIST_WHEEL_H
+
+#include "llist.h"
+
+#define LLIST_WHEEL_BITS 6                            /**<  log2 of slots per level  */
+#define LLIST_WHEEL_SLOTS (1 << LLIST_WHEEL_BITS)     /**<  slots per level  */
+#define LLIST_WHEEL_LEVELS 4                          /**<  levels, covers 2^24 ticks  */
+
+  /**
+   *  @typedef llist_timer
+   *  @brief creates a type for struct @a llist_timer
+   */
+
+typedef struct llist_timer llist_timer;
+
+  /**
+   *  @struct llist_timer
+   *  @brief pending timeout, an @a llist_node of its wheel bucket
+   *
+   *  A pointer to an @a llist_timer is also a pointer to its @a node, so the
+   *  free node and expire functions receive timers as @a llist_node structs.
+   */
+
+struct llist_timer
+{
+  llist_node node;          /**<  bucket list node, @a node.payload is user data  */
+  unsigned long expires;    /**<  tick at which the timer expires  */
+  llist *bucket;            /**<  list currently holding the timer  */
+};
+
+  /**
+   *  @typedef void (*llist_wheel_expire)(llist *expired);
+   *  @brief   creates a type for function prototype to receive a batch of
+   *           expired @a llist_timer structs
+   *
+   *  NOTE:  Timers still in @p expired when the function returns are freed.
+   *         Use <i> llist_wheel_reschedule </i> to keep one.
+   */
+
+typedef void (*llist_wheel_expire)(llist *expired);
+
+  /**
+   *  @typedef llist_wheel
+   *  @brief creates a type for struct @a llist_wheel
+   */
+
+typedef struct llist_wheel llist_wheel;
+
+  /**
+   *  @struct llist_wheel
+   *  @brief LLIST_WHEEL structure, contains metadata for a hierarchical timing
+   *         wheel
+   */
+
+struct llist_wheel
+{
+  llist buckets[LLIST_WHEEL_LEVELS][LLIST_WHEEL_SLOTS];   /**<  timer buckets, by level and slot  */
+  unsigned long now;              /**<  next tick to be processed  */
+  unsigned long pending;          /**<  number of scheduled timers  */
+  llist_free_node free_node;      /**<  user supplied function to free an @a llist_timer  */
+  llist_wheel_expire expire;      /**<  user supplied function to receive expired timers  */
+};
+
+  /*
+   *  LLIST_WHEEL functions
+   */
+
+llist_wheel *llist_wheel_new(void);
+void llist_wheel_free(llist_wheel *w);
+void llist_wheel_set_free(llist_wheel *w, llist_free_node free_func);
+void llist_wheel_set_expire(llist_wheel *w, llist_wheel_expire expire_func);
+llist_timer *llist_wheel_schedule(llist_wheel *w,
+                                  void *payload,
+                                  unsigned long ticks);
+void llist_wheel_reschedule(llist_wheel *w,
+                            llist_timer *timer,
+                            unsigned long ticks);
+void llist_wheel_cancel(llist_wheel *w, llist_timer *timer);
+unsigned long llist_wheel_advance(llist_wheel *w, unsigned long ticks);
+
+#endif //LLIST_WHEEL_H
@@ -0,0 +1,141 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "llist.h"
+
+#define BATCH    256
+#define BATCHES  20000
+
+typedef struct handoff handoff;
+
+struct handoff
+{
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  llist *lists[BATCHES];
+  int produced;
+  int consumed;
+  int plain;
+};
+
+double run(handoff *h, int plain);
+void *producer(void *arg);
+void *consumer(void *arg);
+double now(void);
+
+int main()
+{
+  handoff h;
+  llist_node_cache_stats stats;
+  double elapsed;
+
+  pthread_mutex_init(&h.lock, NULL);
+  pthread_cond_init(&h.cond, NULL);
+
+  printf("%d nodes created by one thread, freed by another\n",
+         BATCH * BATCHES);
+
+  elapsed = run(&h, 1);
+  printf("  malloc/free:      %.3f sec\n", elapsed);
+
+  elapsed = run(&h, 0);
+  printf("  llist_node_new(): %.3f sec\n", elapsed);
+
+  llist_node_cache_stats_get(&stats);
+
+  printf("  allocs=%lu\n", stats.allocs);
+  printf("  hits=%lu (%.2f%%)\n",
+         stats.hits, stats.allocs ? 100.0 * stats.hits / stats.allocs : 0.0);
+  printf("  frees=%lu\n", stats.frees);
+  printf("  depot_gets=%lu\n", stats.depot_gets);
+  printf("  depot_puts=%lu\n", stats.depot_puts);
+
+  llist_node_cache_purge();
+
+  return 0;
+}
+
+double run(handoff *h, int plain)
+{
+  pthread_t p, c;
+  double start;
+
+  h->produced = h->consumed = 0;
+  h->plain = plain;
+
+  start = now();
+
+  pthread_create(&p, NULL, producer, h);
+  pthread_create(&c, NULL, consumer, h);
+  pthread_join(p, NULL);
+  pthread_join(c, NULL);
+
+  return now() - start;
+}
+
+void *producer(void *arg)
+{
+  handoff *h = (handoff *)arg;
+  llist_node *node;
+  llist *ll;
+  int i, j;
+
+  for (i = 0; i < BATCHES; i++)
+  {
+    ll = llist_new();
+    for (j = 0; j < BATCH; j++)
+    {
+      if (h->plain) node = calloc(1, sizeof(llist_node));
+      else node = llist_node_new(NULL);
+      llist_add(ll, llist_position_tail, NULL, node);
+    }
+
+    pthread_mutex_lock(&h->lock);
+    h->lists[h->produced++] = ll;
+    pthread_cond_signal(&h->cond);
+    pthread_mutex_unlock(&h->lock);
+  }
+
+  return NULL;
+}
+
+void *consumer(void *arg)
+{
+  handoff *h = (handoff *)arg;
+  llist_node *node;
+  llist *ll;
+
+  while (h->consumed < BATCHES)
+  {
+    pthread_mutex_lock(&h->lock);
+    while (h->consumed == h->produced) pthread_cond_wait(&h->cond, &h->lock);
+    ll = h->lists[h->consumed++];
+    pthread_mutex_unlock(&h->lock);
+
+    if (!h->plain)
+    {
+      llist_free(ll);
+      continue;
+    }
+
+    while ((node = ll->head))
+    {
+      ll->head = node->next;
+      free(node);
+    }
+    free(ll);
+  }
+
+  return NULL;
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
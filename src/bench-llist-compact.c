@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "llist.h"
+
+#define NODES   1000000
+#define PASSES  10
+
+double traverse(llist *ll, intptr_t *sum);
+double now(void);
+
+int main(int argc, char *argv[])
+{
+  llist *ll = NULL;
+  llist_node **nodes = NULL;
+  llist_node *swap;
+  intptr_t sum;
+  int count = NODES;
+  double start;
+  int i, j;
+
+  if (argc > 1) count = atoi(argv[1]);
+
+  if (!(nodes = malloc(count * sizeof(llist_node *)))) return 1;
+
+    /*
+     *  link the nodes in random order, as after a long run of churn
+     */
+
+  for (i = 0; i < count; i++) nodes[i] = llist_node_new((void *)(intptr_t)i);
+
+  srand(1);
+  for (i = count - 1; i > 0; i--)
+  {
+    j = rand() % (i + 1);
+    swap = nodes[i];
+    nodes[i] = nodes[j];
+    nodes[j] = swap;
+  }
+
+  ll = llist_new();
+  for (i = 0; i < count; i++) llist_add(ll, llist_position_tail, NULL, nodes[i]);
+  free(nodes);
+
+  printf("%d scattered nodes\n", count);
+  printf("  traversal before llist_compact(): %8.3f ms\n", traverse(ll, &sum));
+
+  start = now();
+  llist_compact(ll, 0);
+  printf("  llist_compact():                  %8.3f ms\n", (now() - start) * 1e3);
+
+  printf("  traversal after llist_compact():  %8.3f ms\n", traverse(ll, &sum));
+
+  llist_free(ll);
+
+  return 0;
+}
+
+double traverse(llist *ll, intptr_t *sum)
+{
+  llist_node *node;
+  double start;
+  int i;
+
+  *sum = 0;
+  start = now();
+
+  for (i = 0; i < PASSES; i++)
+    for (node = ll->head; node; node = node->next)
+      *sum += (intptr_t)node->payload;
+
+  return (now() - start) * 1e3 / PASSES;
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "llist.h"
+
+#define NODES    100000
+#define LOOKUPS  500
+
+typedef struct item item;
+
+struct item
+{
+  char name[56];
+  int id;
+};
+
+void run(llist *ll, const char *name, int nodes);
+int cmp_node(llist_node *a, llist_node *b);
+uint64_t key_node(llist_node *node);
+double now(void);
+
+unsigned long _compared = 0;
+
+int main(int argc, char *argv[])
+{
+  llist *ll = NULL;
+  item **items = NULL;
+  item *swap;
+  int nodes = NODES;
+  int i, j;
+
+  if (argc > 1) nodes = atoi(argv[1]);
+
+  if (!(items = malloc(nodes * sizeof(item *)))) return 1;
+
+  printf("%d nodes, %d lookups, half of them misses\n", nodes, LOOKUPS);
+#if !LLIST_NODE_KEY
+  printf("built without --enable-node-key, keys are not kept in nodes\n");
+#endif
+
+    /*
+     *  payloads allocated in one order and linked in another, so that a scan
+     *  touches them all over the heap, as in a long lived list
+     */
+
+  srand(1);
+  for (i = 0; i < nodes; i++)
+  {
+    items[i] = malloc(sizeof(item));
+    items[i]->id = i;
+    sprintf(items[i]->name, "item%d", i);
+  }
+  for (i = nodes - 1; i > 0; i--)
+  {
+    j = rand() % (i + 1);
+    swap = items[i];
+    items[i] = items[j];
+    items[j] = swap;
+  }
+
+  ll = llist_new();
+  llist_set_cmp(ll, cmp_node);
+  for (i = 0; i < nodes; i++)
+    llist_add(ll, llist_position_tail, NULL, llist_node_new(items[i]));
+
+  run(ll, "cmp_node only", nodes);
+
+  llist_set_key(ll, key_node);
+  run(ll, "llist_set_key", nodes);
+
+  llist_free(ll);
+  for (i = 0; i < nodes; i++) free(items[i]);
+  free(items);
+
+  return 0;
+}
+
+void run(llist *ll, const char *name, int nodes)
+{
+  item it;
+  llist_node needle = { NULL, NULL, &it };
+  double start;
+  int found = 0;
+  int i;
+
+  memset(&it, 0, sizeof(item));
+
+  srand(2);
+  _compared = 0;
+  start = now();
+
+  for (i = 0; i < LOOKUPS; i++)
+  {
+    it.id = rand() % (nodes * 2);
+    if (llist_find(ll, &needle)) found++;
+  }
+
+  printf("  %-16s %8.3f sec, %d found, %lu cmp_node calls\n",
+         name, now() - start, found, _compared);
+}
+
+int cmp_node(llist_node *a, llist_node *b)
+{
+  item *a_it = (item *)a->payload;
+  item *b_it = (item *)b->payload;
+
+  _compared++;
+
+  return (a_it->id > b_it->id) - (a_it->id < b_it->id);
+}
+
+uint64_t key_node(llist_node *node)
+{
+  return ((item *)node->payload)->id;
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
@@ -0,0 +1,158 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#include "llist_lru.h"
+
+#define KEYS      100000
+#define REQUESTS  1000000
+#define CAPACITY  1000
+
+int cmp_node(llist_node *a, llist_node *b);
+unsigned long hash_node(llist_node *node);
+int *make_trace(int keys, int requests);
+double now(void);
+
+int main(int argc, char *argv[])
+{
+  llist *ll = NULL;
+  llist_lru *lru = NULL;
+  llist_node needle = { NULL, NULL, NULL };
+  llist_node *node = NULL;
+  int *trace = NULL;
+  int capacity = CAPACITY;
+  int requests = REQUESTS;
+  int count = 0;
+  unsigned long hits = 0;
+  double start;
+  int i;
+
+  if (argc > 1) capacity = atoi(argv[1]);
+  if (argc > 2) requests = atoi(argv[2]);
+
+  if (!(trace = make_trace(KEYS, requests))) return 1;
+
+  printf("zipf(0.99) trace: %d keys, %d requests, capacity %d\n",
+         KEYS, requests, capacity);
+
+    /*
+     *  hand rolled cache: llist_find() + llist_remove() of the tail
+     */
+
+  ll = llist_new();
+  llist_set_cmp(ll, cmp_node);
+
+  start = now();
+
+  for (i = 0; i < requests; i++)
+  {
+    needle.payload = (void *)(intptr_t)trace[i];
+
+    if ((node = llist_find(ll, &needle)))
+    {
+      hits++;
+      llist_unlink(ll, node);
+      llist_add(ll, llist_position_head, NULL, node);
+      continue;
+    }
+
+    llist_add(ll, llist_position_head, NULL, llist_node_new(needle.payload));
+    if (++count > capacity)
+    {
+      llist_remove(ll, ll->tail);
+      count--;
+    }
+  }
+
+  printf("llist:     %8.3f sec, hit rate %.2f%%\n",
+         now() - start, 100.0 * hits / requests);
+
+  llist_free(ll);
+
+    /*
+     *  llist_lru
+     */
+
+  lru = llist_lru_new(capacity, 0);
+  llist_set_cmp(lru->ll, cmp_node);
+  llist_lru_set_hash(lru, hash_node);
+
+  start = now();
+
+  for (i = 0; i < requests; i++)
+  {
+    needle.payload = (void *)(intptr_t)trace[i];
+
+    if (!llist_lru_get(lru, &needle))
+      llist_lru_put(lru, llist_node_new(needle.payload));
+  }
+
+  printf("llist_lru: %8.3f sec, hit rate %.2f%%, evictions %lu\n",
+         now() - start,
+         100.0 * lru->hits / requests,
+         lru->evictions);
+
+  llist_lru_free(lru);
+  free(trace);
+
+  return 0;
+}
+
+int cmp_node(llist_node *a, llist_node *b)
+{
+  intptr_t a_key = (intptr_t)a->payload;
+  intptr_t b_key = (intptr_t)b->payload;
+
+  return (a_key > b_key) - (a_key < b_key);
+}
+
+unsigned long hash_node(llist_node *node)
+{
+  return (unsigned long)(intptr_t)node->payload * 2654435761UL;
+}
+
+int *make_trace(int keys, int requests)
+{
+  double *cdf = NULL;
+  int *trace = NULL;
+  double sum = 0.0;
+  double r;
+  int lo, hi, mid;
+  int i;
+
+  cdf = malloc(keys * sizeof(double));
+  trace = malloc(requests * sizeof(int));
+  if (!cdf || !trace) goto exit;
+
+  for (i = 0; i < keys; i++) cdf[i] = sum += 1.0 / pow(i + 1, 0.99);
+  for (i = 0; i < keys; i++) cdf[i] /= sum;
+
+  srand(1);
+
+  for (i = 0; i < requests; i++)
+  {
+    r = (double)rand() / RAND_MAX;
+    for (lo = 0, hi = keys - 1; lo < hi; )
+    {
+      mid = (lo + hi) / 2;
+      if (cdf[mid] < r) lo = mid + 1;
+      else hi = mid;
+    }
+    trace[i] = lo + 1;
+  }
+
+exit:
+  free(cdf);
+  return trace;
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/epoll.h>
+
+#include "llist_queue.h"
+
+#define MESSAGES  2000
+#define GAP       200
+
+typedef struct bench bench;
+
+struct bench
+{
+  llist_queue *q;
+  int mode;
+  double latency[MESSAGES];
+  int received;
+};
+
+enum { mode_poll, mode_block, mode_eventfd };
+
+void run(int mode, const char *name);
+void *consumer(void *arg);
+int cmp_double(const void *a, const void *b);
+double now(void);
+
+int main()
+{
+  printf("%d messages, %d usec apart, wakeup to dequeue latency (usec)\n",
+         MESSAGES, GAP);
+
+  run(mode_poll, "sleep/poll llist_head()");
+  run(mode_block, "llist_queue_pop()");
+  run(mode_eventfd, "epoll + eventfd");
+
+  return 0;
+}
+
+void run(int mode, const char *name)
+{
+  bench *b;
+  pthread_t c;
+  double *stamp;
+  double sum = 0.0;
+  int i;
+
+  if (!(b = malloc(sizeof(bench)))) return;
+
+  b->q = llist_queue_new(0);
+  b->mode = mode;
+  b->received = 0;
+
+  pthread_create(&c, NULL, consumer, b);
+  usleep(10000);
+
+  for (i = 0; i < MESSAGES; i++)
+  {
+    stamp = malloc(sizeof(double));
+    *stamp = now();
+    llist_queue_push(b->q, llist_node_new(stamp), -1);
+    usleep(GAP);
+  }
+
+  llist_queue_close(b->q);
+  pthread_join(c, NULL);
+
+  for (i = 0; i < b->received; i++) sum += b->latency[i];
+  qsort(b->latency, b->received, sizeof(double), cmp_double);
+
+  printf("  %-24s avg %8.1f  p50 %8.1f  p99 %8.1f  max %8.1f\n",
+         name,
+         sum / b->received,
+         b->latency[b->received / 2],
+         b->latency[b->received * 99 / 100],
+         b->latency[b->received - 1]);
+
+  llist_queue_free(b->q);
+  free(b);
+}
+
+void *consumer(void *arg)
+{
+  bench *b = (bench *)arg;
+  struct epoll_event ev;
+  llist_node *node = NULL;
+  uint64_t value;
+  int epfd = -1;
+  int efd;
+
+  if (b->mode == mode_eventfd)
+  {
+    efd = llist_queue_eventfd(b->q);
+    epfd = epoll_create1(0);
+    ev.events = EPOLLIN;
+    ev.data.fd = efd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, efd, &ev);
+  }
+
+  for (;;)
+  {
+    switch (b->mode)
+    {
+      case mode_poll:
+        if (!(node = llist_queue_pop(b->q, 0)))
+        {
+          if (b->q->closed) goto exit;
+          usleep(1000);
+          continue;
+        }
+        break;
+      case mode_block:
+        if (!(node = llist_queue_pop(b->q, -1))) goto exit;
+        break;
+      case mode_eventfd:
+        if (!(node = llist_queue_pop(b->q, 0)))
+        {
+          if (b->q->closed) goto exit;
+          epoll_wait(epfd, &ev, 1, -1);
+          if (read(ev.data.fd, &value, sizeof(value)) < 0) continue;
+          continue;
+        }
+        break;
+    }
+
+    b->latency[b->received++] = (now() - *(double *)node->payload) * 1e6;
+    free(node->payload);
+    llist_node_free(node);
+  }
+
+exit:
+  if (epfd >= 0) close(epfd);
+  return NULL;
+}
+
+int cmp_double(const void *a, const void *b)
+{
+  return (*(double *)a > *(double *)b) - (*(double *)a < *(double *)b);
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
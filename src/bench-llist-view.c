@@ -0,0 +1,156 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "llist_view.h"
+
+#define NODES    20000
+#define CHANGES  200
+
+typedef struct item item;
+
+struct item
+{
+  int id;
+  int score;
+};
+
+llist *rebuild(llist *ll);
+void change(llist *ll, int id, int drop);
+int cmp_score(llist_node *a, llist_node *b);
+int even_node(llist_node *node);
+void free_node(llist_node *node);
+double now(void);
+
+long _checksum = 0;
+
+int main(int argc, char *argv[])
+{
+  llist *ll = NULL;
+  llist *copy = NULL;
+  llist_view *view = NULL;
+  int nodes = NODES;
+  double start;
+  long checksum;
+  int i;
+
+  if (argc > 1) nodes = atoi(argv[1]);
+
+  printf("%d nodes, %d changes, even ids ordered by score read after each\n",
+         nodes, CHANGES);
+
+    /*
+     *  copy, filter and sort the base list after every change
+     */
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+
+  srand(1);
+  for (i = 0; i < nodes; i++) change(ll, i, 0);
+
+  start = now();
+
+  for (i = 0; i < CHANGES; i++)
+  {
+    change(ll, nodes + i, 1);
+    copy = rebuild(ll);
+    _checksum += ((item *)copy->head->payload)->score;
+    llist_free(copy);
+  }
+
+  printf("rebuild:    %8.3f sec\n", now() - start);
+  checksum = _checksum;
+
+  llist_free(ll);
+
+    /*
+     *  llist_view
+     */
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+
+  srand(1);
+  for (i = 0; i < nodes; i++) change(ll, i, 0);
+
+  start = now();
+
+  view = llist_view_new(ll, even_node, cmp_score);
+
+  _checksum = 0;
+  for (i = 0; i < CHANGES; i++)
+  {
+    change(ll, nodes + i, 1);
+    _checksum += ((item *)view->ll->head->payload)->score;
+  }
+
+  printf("llist_view: %8.3f sec%s\n",
+         now() - start, _checksum == checksum ? "" : " (MISMATCH)");
+
+  llist_view_free(view);
+  llist_free(ll);
+
+  return 0;
+}
+
+llist *rebuild(llist *ll)
+{
+  llist *copy = llist_new();
+  llist_node *node;
+
+  llist_set_cmp(copy, cmp_score);
+
+  for (node = ll->head; node; node = node->next)
+    if (even_node(node))
+      llist_add(copy, llist_position_tail, NULL, llist_node_new(node->payload));
+
+  llist_sort(copy);
+
+  return copy;
+}
+
+    /*
+     *  adds a node with a random score, and optionally drops the oldest
+     */
+
+void change(llist *ll, int id, int drop)
+{
+  item *it = malloc(sizeof(item));
+
+  it->id = id;
+  it->score = rand() % 1000000;
+  llist_add(ll, llist_position_tail, NULL, llist_node_new(it));
+
+  if (drop) llist_remove(ll, ll->head);
+}
+
+int cmp_score(llist_node *a, llist_node *b)
+{
+  item *a_it = (item *)a->payload;
+  item *b_it = (item *)b->payload;
+
+  return (a_it->score > b_it->score) - (a_it->score < b_it->score);
+}
+
+int even_node(llist_node *node)
+{
+  return !(((item *)node->payload)->id % 2);
+}
+
+void free_node(llist_node *node)
+{
+  if (!node) return;
+
+  free(node->payload);
+  llist_node_free(node);
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
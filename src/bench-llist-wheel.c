@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "llist_wheel.h"
+
+#define CONNECTIONS  10000
+#define TIMEOUT      500
+#define TICKS        1000
+#define EVENTS       2
+
+typedef struct conn conn;
+
+struct conn
+{
+  unsigned long expires;
+  llist_node *node;
+  llist_timer *timer;
+};
+
+void sorted_schedule(llist *ll, conn *c, unsigned long now);
+void wheel_expire(llist *expired);
+double now(void);
+
+unsigned long _expired = 0;
+
+int main(int argc, char *argv[])
+{
+  llist *ll = NULL;
+  llist_wheel *w = NULL;
+  conn *conns = NULL;
+  conn *c;
+  unsigned long tick;
+  unsigned long expired;
+  int connections = CONNECTIONS;
+  double start;
+  int i, j;
+
+  if (argc > 1) connections = atoi(argv[1]);
+
+  if (!(conns = calloc(connections, sizeof(conn)))) return 1;
+
+  printf("%d connections, %d tick timeout, %d ticks, %d events per tick\n",
+         connections, TIMEOUT, TICKS, EVENTS * connections / 1000);
+
+    /*
+     *  sorted llist: walk to the insertion point, llist_remove() to cancel
+     */
+
+  ll = llist_new();
+
+  srand(1);
+  start = now();
+
+  for (i = 0; i < connections; i++)
+    sorted_schedule(ll, &conns[i], rand() % TIMEOUT);
+
+  for (tick = 0, expired = 0; tick < TICKS; tick++)
+  {
+    for (j = 0; j < EVENTS * connections / 1000; j++)
+    {
+      c = &conns[rand() % connections];
+      if (c->node) llist_remove(ll, c->node);
+      sorted_schedule(ll, c, tick + TIMEOUT);
+    }
+
+    while (ll->head && ((conn *)ll->head->payload)->expires <= tick)
+    {
+      ((conn *)ll->head->payload)->node = NULL;
+      llist_remove(ll, ll->head);
+      expired++;
+    }
+  }
+
+  printf("sorted llist: %8.3f sec, %lu expired\n", now() - start, expired);
+
+  llist_free(ll);
+
+    /*
+     *  llist_wheel
+     */
+
+  w = llist_wheel_new();
+  llist_wheel_set_expire(w, wheel_expire);
+
+  srand(1);
+  start = now();
+
+  for (i = 0; i < connections; i++)
+    conns[i].timer = llist_wheel_schedule(w, &conns[i], rand() % TIMEOUT);
+
+  for (tick = 0; tick < TICKS; tick++)
+  {
+    for (j = 0; j < EVENTS * connections / 1000; j++)
+    {
+      c = &conns[rand() % connections];
+      if (c->timer) llist_wheel_reschedule(w, c->timer, TIMEOUT);
+      else c->timer = llist_wheel_schedule(w, c, TIMEOUT);
+    }
+
+    llist_wheel_advance(w, 1);
+  }
+
+  printf("llist_wheel:  %8.3f sec, %lu expired\n", now() - start, _expired);
+
+  llist_wheel_free(w);
+  free(conns);
+
+  return 0;
+}
+
+void sorted_schedule(llist *ll, conn *c, unsigned long expires)
+{
+  llist_node *node;
+
+  c->expires = expires;
+  c->node = llist_node_new(c);
+
+  for (node = ll->head; node; node = node->next)
+    if (((conn *)node->payload)->expires > expires) break;
+
+  if (node) llist_add(ll, llist_position_before, node, c->node);
+  else llist_add(ll, llist_position_tail, NULL, c->node);
+}
+
+void wheel_expire(llist *expired)
+{
+  llist_node *node;
+
+  for (node = expired->head; node; node = node->next)
+  {
+    ((conn *)node->payload)->timer = NULL;
+    _expired++;
+  }
+}
+
+double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
@@ -22,8 +22,388 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 #include "llist.h"
+#include "llist_view_hooks.h"
+#include "llist_lru_hooks.h"
+
+#define LLIST_MAGAZINE_SIZE 64
+#define LLIST_DEPOT_SIZE 256
+#define LLIST_BLOCK_MIN 64
+#define LLIST_BLOCK_MAX 16384
+#define LLIST_COMPACT_CHECK 256
+
+  /**
+   *  @struct llist_block
+   *  @brief contiguous array of nodes, owned by an @a llist, see
+   *         <i> llist_compact </i>
+   */
+
+struct llist_block
+{
+  struct llist_block *next;   /**<  next block owned by the list  */
+  size_t size;                /**<  number of node slots  */
+  size_t used;                /**<  number of node slots handed out  */
+  size_t live;                /**<  number of node slots still in the list  */
+  llist_node nodes[];         /**<  node slots, in list order  */
+};
+
+  /**
+   *  @struct llist_magazine
+   *  @brief thread local stack of free nodes, linked through @a next
+   */
+
+typedef struct llist_magazine
+{
+  llist_node *top;    /**<  most recently freed node  */
+  int count;          /**<  number of nodes on stack  */
+} llist_magazine;
+
+  /*
+   *  Node cache.  Each thread keeps two magazines of free nodes, full
+   *  magazines are exchanged with a global depot, linked through the
+   *  @a previous pointer of their top node.
+   */
+
+static __thread llist_magazine cache_loaded;
+static __thread llist_magazine cache_previous;
+static __thread llist_node_cache_stats cache_stats;
+static __thread int cache_registered = 0;
+
+static pthread_mutex_t depot_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t depot_once = PTHREAD_ONCE_INIT;
+static pthread_key_t depot_key;
+static llist_node *depot = NULL;
+static int depot_count = 0;
+static llist_node_cache_stats depot_stats;
+
+    /*
+     * private functions
+     */
+
+static void magazine_release(llist_magazine *mag)
+{
+  llist_node *node;
+
+  while ((node = mag->top))
+  {
+    mag->top = node->next;
+    free(node);
+  }
+
+  mag->count = 0;
+}
+
+static void cache_stats_flush(void)
+{
+  depot_stats.allocs += cache_stats.allocs;
+  depot_stats.hits += cache_stats.hits;
+  depot_stats.frees += cache_stats.frees;
+  depot_stats.depot_gets += cache_stats.depot_gets;
+  depot_stats.depot_puts += cache_stats.depot_puts;
+
+  memset(&cache_stats, 0, sizeof(llist_node_cache_stats));
+}
+
+static void cache_thread_exit(void *unused)
+{
+  pthread_mutex_lock(&depot_lock);
+
+  if (cache_previous.count == LLIST_MAGAZINE_SIZE &&
+      depot_count < LLIST_DEPOT_SIZE)
+  {
+    cache_previous.top->previous = depot;
+    depot = cache_previous.top;
+    depot_count++;
+    cache_previous.top = NULL;
+    cache_previous.count = 0;
+  }
+
+  cache_stats_flush();
+
+  pthread_mutex_unlock(&depot_lock);
+
+  magazine_release(&cache_loaded);
+  magazine_release(&cache_previous);
+
+    /*
+     *  other thread specific destructors may still free nodes, so let the
+     *  next cache_put register again, which runs this destructor once more
+     */
+
+  cache_registered = 0;
+}
+
+static void cache_init(void)
+{
+  pthread_key_create(&depot_key, cache_thread_exit);
+}
+
+static void cache_register(void)
+{
+  if (cache_registered) return;
+
+  pthread_once(&depot_once, cache_init);
+  pthread_setspecific(depot_key, &cache_registered);
+  cache_registered = 1;
+}
+
+static llist_node *cache_get(void)
+{
+  llist_magazine swap;
+  llist_node *node;
+
+  cache_stats.allocs++;
+
+  if (!cache_loaded.count && cache_previous.count)
+  {
+    swap = cache_loaded;
+    cache_loaded = cache_previous;
+    cache_previous = swap;
+  }
+
+  if (!cache_loaded.count)
+  {
+    cache_register();
+
+    pthread_mutex_lock(&depot_lock);
+    if (depot)
+    {
+      cache_loaded.top = depot;
+      cache_loaded.count = LLIST_MAGAZINE_SIZE;
+      depot = depot->previous;
+      depot_count--;
+      cache_stats.depot_gets++;
+    }
+    cache_stats_flush();
+    pthread_mutex_unlock(&depot_lock);
+  }
+
+  if (!cache_loaded.count) return malloc(sizeof(llist_node));
+
+  node = cache_loaded.top;
+  cache_loaded.top = node->next;
+  cache_loaded.count--;
+  cache_stats.hits++;
+
+  return node;
+}
+
+static void cache_put(llist_node *node)
+{
+  llist_magazine swap;
+
+  cache_stats.frees++;
+
+  cache_register();
+
+  if (cache_loaded.count == LLIST_MAGAZINE_SIZE &&
+      cache_previous.count < LLIST_MAGAZINE_SIZE)
+  {
+    swap = cache_loaded;
+    cache_loaded = cache_previous;
+    cache_previous = swap;
+  }
+
+  if (cache_loaded.count == LLIST_MAGAZINE_SIZE)
+  {
+    pthread_mutex_lock(&depot_lock);
+    if (depot_count < LLIST_DEPOT_SIZE)
+    {
+      cache_previous.top->previous = depot;
+      depot = cache_previous.top;
+      depot_count++;
+      cache_previous.top = NULL;
+      cache_previous.count = 0;
+      cache_stats.depot_puts++;
+    }
+    cache_stats_flush();
+    pthread_mutex_unlock(&depot_lock);
+
+    magazine_release(&cache_previous);
+
+    cache_previous = cache_loaded;
+    cache_loaded.top = NULL;
+    cache_loaded.count = 0;
+  }
+
+  node->next = cache_loaded.top;
+  cache_loaded.top = node;
+  cache_loaded.count++;
+}
+
+static int llist_generate(llist *ll, int count)
+{
+  llist_node *node;
+  int added = 0;
+
+  while (ll->gen_node && added < count)
+  {
+    if (!(node = ll->gen_node(ll->gen_state)))
+    {
+      ll->gen_node = NULL;
+      ll->gen_state = NULL;
+      break;
+    }
+
+    node->next = NULL;
+    node->previous = ll->tail;
+    if (ll->tail) ll->tail->next = node;
+    else ll->head = node;
+    ll->tail = node;
+
+#if LLIST_NODE_KEY
+    if (ll->key_node) node->key = ll->key_node(node);
+#endif
+    if (ll->views) llist_view_added(ll, node);
+
+    added++;
+  }
+
+  return added;
+}
+
+static llist_block *llist_block_of(llist *ll, llist_node *node)
+{
+  llist_block *block;
+
+  for (block = ll->blocks; block; block = block->next)
+    if (node >= block->nodes && node < block->nodes + block->size) break;
+
+  return block;
+}
+
+static llist_block *llist_block_new(llist *ll)
+{
+  llist_block *block;
+  size_t size;
+
+  size = ll->blocks ? ll->blocks->size * 2 : LLIST_BLOCK_MIN;
+  if (size > LLIST_BLOCK_MAX) size = LLIST_BLOCK_MAX;
+
+  if (!(block = malloc(sizeof(llist_block) + size * sizeof(llist_node))))
+    return NULL;
+
+  block->size = size;
+  block->used = 0;
+  block->live = 0;
+  block->next = ll->blocks;
+  ll->blocks = block;
+
+  return block;
+}
+
+static void llist_block_release(llist *ll, llist_block *block)
+{
+  llist_block **link;
+
+  if (--block->live) return;
+  if (ll->compacting && block == ll->blocks) return;
+
+  for (link = &ll->blocks; *link != block; link = &(*link)->next);
+  *link = block->next;
+
+  if (ll->compact_older == block) ll->compact_older = block->next;
+
+  free(block);
+}
+
+    /*
+     *  free_node releases the node with its payload, so hand it a heap copy
+     *  and return the block slot here
+     */
+
+static int llist_dispose_block(llist *ll, llist_node *node, llist_block *block)
+{
+  llist_node *copy = NULL;
+
+  if (ll->free_node)
+  {
+    if (!(copy = llist_node_new(node->payload))) return 0;
+    *copy = *node;
+    ll->free_node(copy);
+  }
+
+  llist_block_release(ll, block);
+
+  return 1;
+}
+
+    /*
+     *  relocated nodes whose heap copy could not be allocated keep their
+     *  block slot, and wait on ll->unfreed for another try
+     */
+
+static void llist_dispose_unfreed(llist *ll)
+{
+  llist_node *node;
+
+  while ((node = ll->unfreed))
+  {
+    ll->unfreed = node->next;
+    if (llist_dispose_block(ll, node, llist_block_of(ll, node))) continue;
+    ll->unfreed = node;
+    break;
+  }
+}
+
+static void llist_dispose(llist *ll, llist_node *node)
+{
+  llist_block *block = NULL;
+
+  if (ll->blocks) block = llist_block_of(ll, node);
+
+  if (!block)
+  {
+    if (ll->free_node) ll->free_node(node);
+    else llist_node_free(node);
+    return;
+  }
+
+  if (ll->unfreed) llist_dispose_unfreed(ll);
+
+  if (llist_dispose_block(ll, node, block)) return;
+
+  node->next = ll->unfreed;
+  ll->unfreed = node;
+}
+
+static llist_node *llist_merge(llist_node *a,
+                               llist_node *b,
+                               llist_cmp_node cmp)
+{
+  llist_node merged;
+  llist_node *last = &merged;
+
+  while (a && b)
+  {
+    if (cmp(b, a) < 0)
+    {
+      last->next = b;
+      b = b->next;
+    }
+    else
+    {
+      last->next = a;
+      a = a->next;
+    }
+    last = last->next;
+  }
+  last->next = a ? a : b;
+
+  return merged.next;
+}
+
+static double llist_clock(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
 
     /*
      * public functions
@@ -103,6 +483,8 @@ llist *llist_new(void)
    *  NOTE: If @p ll->dup_node is not set, then a shallow copy is performed.
    *        This can be useful when having different list sort or filters.
    *
+   *  NOTE: A lazy @p ll is fully materialized first, see <i> llist_set_gen </i>.
+   *
    *  @param ll - pointer to @a llist struct
    *
    *  @return pointer to new @a llist
@@ -122,6 +504,9 @@ llist *llist_dup(llist *ll)
   llist_set_dup(new_ll, ll->dup_node);
   llist_set_free(new_ll, ll->free_node);
   llist_set_cmp(new_ll, ll->cmp_node);
+  llist_set_key(new_ll, ll->key_node);
+
+  while (llist_generate(ll, ll->gen_ahead));
 
   node_p = ll->head;
 
@@ -153,19 +538,33 @@ exit:
 void llist_free(llist *ll)
 {
   llist_node *node, *next;
+  llist_block *block;
 
   if (!ll) goto exit;
 
+  if (ll->views) llist_view_detach(ll);
+
   node = ll->head;
 
   while (node)
   {
     next = node->next;
-    if (ll->free_node) ll->free_node(node);
-    else free(node);
+    llist_dispose(ll, node);
     node = next;
   }
 
+    /*
+     *  if a heap copy still cannot be had, the payload is lost with its block
+     */
+
+  if (ll->unfreed) llist_dispose_unfreed(ll);
+
+  while ((block = ll->blocks))
+  {
+    ll->blocks = block->next;
+    free(block);
+  }
+
   free(ll);
 
 exit:
@@ -210,6 +609,11 @@ void llist_set_dup(llist *ll, llist_dup_node dup_func)
    *
    *  @brief Sets node free function in @p ll
    *
+   *  NOTE:  A node relocated by <i> llist_compact </i> lives in a block owned
+   *         by @p ll, so @p free_func is handed a heap copy of it, at a
+   *         different address than the node had in the list.  If the copy
+   *         cannot be allocated, the call is retried on a later removal.
+   *
    *  @param  ll - pointer to @a llist
    *  @param  free_func - pointer to function that frees a @a llist_node
    *
@@ -239,6 +643,220 @@ void llist_set_cmp(llist *ll, llist_cmp_node cmp_func)
   if (ll) ll->cmp_node = cmp_func;
 }
 
+  /**
+   *  @fn void llist_set_key(llist *ll, llist_key_node key_func)
+   *
+   *  @brief Sets node key function in @p ll
+   *
+   *  The key of each node is computed once, when it enters @p ll, and kept in
+   *  the node.  <i> llist_find </i> then calls the compare node function only
+   *  on nodes whose key matches that of the needle.  Keys of the nodes
+   *  already in @p ll are computed here.
+   *
+   *  NOTE:  Keys are only kept when the library is built with
+   *         --enable-node-key, which adds node->key to every @a llist_node.
+   *         Otherwise @p key_func is only used by an @a llist_lru on @p ll
+   *         without a hash function.
+   *
+   *  NOTE:  If the payload of a node changes in a way that affects its key,
+   *         the caller MUST update node->key with @p key_func.
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  key_func - pointer to function that extracts a node key, NULL
+   *          to stop using keys
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_set_key(llist *ll, llist_key_node key_func)
+{
+#if LLIST_NODE_KEY
+  llist_node *node;
+#endif
+
+  if (!ll) goto exit;
+
+  ll->key_node = key_func;
+
+#if LLIST_NODE_KEY
+  if (!key_func) goto exit;
+
+  for (node = ll->head; node; node = node->next)
+    node->key = key_func(node);
+#endif
+
+exit:
+}
+
+  /**
+   *  @fn void llist_set_gen(llist *ll,
+   *                         llist_gen_node gen_func,
+   *                         void *state,
+   *                         int read_ahead)
+   *
+   *  @brief Makes @p ll a lazy list, fed by a node generator
+   *
+   *  Nodes are not created until traversal reaches them.  When
+   *  <i> llist_head </i>, <i> llist_next </i>, <i> llist_find </i> or
+   *  <i> llist_find_payload </i> run off the tail of @p ll, up to
+   *  @p read_ahead nodes are taken from @p gen_func and appended.
+   *  <i> llist_tail </i> and <i> llist_dup </i> materialize the whole list.
+   *
+   *  NOTE:  Generated nodes belong to @p ll, they are not passed through
+   *         @p ll->dup_node.  @p state belongs to the caller, @p ll drops its
+   *         reference once @p gen_func returns NULL.
+   *
+   *  NOTE:  Positions given to <i> llist_add </i> refer to the nodes created
+   *         so far, generated nodes always follow the tail.
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  gen_func - pointer to function that creates the next
+   *                     @a llist_node, or returns NULL when there are no more
+   *  @param  state - user data passed to @p gen_func
+   *  @param  read_ahead - number of nodes to create at a time, at least 1
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_set_gen(llist *ll,
+                   llist_gen_node gen_func,
+                   void *state,
+                   int read_ahead)
+{
+  if (!ll) return;
+
+  ll->gen_node = gen_func;
+  ll->gen_state = state;
+  ll->gen_ahead = read_ahead > 0 ? read_ahead : 1;
+}
+
+  /**
+   *  @fn void llist_set_move(llist *ll, llist_move_node move_func)
+   *
+   *  @brief Sets node move notification function in @p ll
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  move_func - pointer to function called by <i> llist_compact </i>
+   *                      for every relocated @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_set_move(llist *ll, llist_move_node move_func)
+{
+  if (ll) ll->move_node = move_func;
+}
+
+  /**
+   *  @fn int llist_compact(llist *ll, long budget)
+   *
+   *  @brief Relocates the nodes of @p ll into contiguous blocks, in list order
+   *
+   *  Each node is copied into the next free slot of a block owned by @p ll,
+   *  relinked in place of the original, and the original is released.  Head,
+   *  tail and current are fixed up, and @p ll->move_node, when set, is called
+   *  with the old and new address of every node, before the old one is
+   *  released.
+   *
+   *  With a @p budget, compaction stops once about @p budget microseconds
+   *  have passed, and the next call resumes where it left off.  Nodes may be
+   *  added and removed between calls.
+   *
+   *  NOTE:  Relocated nodes belong to @p ll.  They are freed by
+   *         <i> llist_remove </i> and <i> llist_free </i> as usual (the free
+   *         node function is handed a heap copy), and by
+   *         <i> llist_release </i> once detached with <i> llist_unlink </i>,
+   *         but MUST NOT be freed by the caller directly.
+   *
+   *  NOTE:  The recency list of an @a llist_lru may be compacted, the cache
+   *         follows its nodes.  Lists with @p ll->pinned set, such as the
+   *         buckets of an @a llist_wheel, whose nodes are embedded in
+   *         @a llist_timer structs, are never compacted.
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  budget - time limit in microseconds, 0 for no limit
+   *
+   *  @return 1 when the whole list has been compacted, 0 if more work remains
+   *          or on failure, always 0 for a pinned @p ll
+   */
+
+int llist_compact(llist *ll, long budget)
+{
+  llist_block *block, *owner;
+  llist_node *node, *moved;
+  double deadline = 0.0;
+  int steps = 0;
+
+  if (!ll || ll->pinned) return 0;
+
+  if (budget > 0) deadline = llist_clock() + budget;
+
+  if (!ll->compacting)
+  {
+    ll->compact_older = ll->blocks;
+    if (!llist_block_new(ll)) return 0;
+    ll->compacting = 1;
+    ll->compact_next = ll->head;
+  }
+
+  while ((node = ll->compact_next))
+  {
+    if (deadline && !(++steps % LLIST_COMPACT_CHECK) && llist_clock() > deadline)
+      return 0;
+
+      /*
+       *  a node relocated earlier in this compaction, then unlinked and added
+       *  again further on, is already in place
+       */
+
+    owner = llist_block_of(ll, node);
+    for (block = ll->blocks; block != ll->compact_older; block = block->next)
+      if (block == owner) break;
+    if (block != ll->compact_older)
+    {
+      ll->compact_next = node->next;
+      continue;
+    }
+
+    block = ll->blocks;
+    if (block->used == block->size && !(block = llist_block_new(ll))) return 0;
+
+    moved = &block->nodes[block->used++];
+    block->live++;
+
+    *moved = *node;
+    if (moved->previous) moved->previous->next = moved;
+    else ll->head = moved;
+    if (moved->next) moved->next->previous = moved;
+    else ll->tail = moved;
+    if (ll->current == node) ll->current = moved;
+
+    ll->compact_next = moved->next;
+
+    if (ll->move_node) ll->move_node(node, moved);
+    if (ll->views) llist_view_moved(ll, node, moved);
+    if (ll->lru) llist_lru_moved(ll->lru, node, moved);
+
+    if (owner) llist_block_release(ll, owner);
+    else llist_node_free(node);
+  }
+
+  ll->compacting = 0;
+  ll->compact_older = NULL;
+
+  block = ll->blocks;
+  if (block && !block->live)
+  {
+    ll->blocks = block->next;
+    free(block);
+  }
+
+  return 1;
+}
+
   /**
    *  @fn void llist_add(llist *ll,
    *                     llist_position position,
@@ -277,6 +895,9 @@ void llist_add(llist *ll,
   else if (!(added = ll->dup_node(node))) goto exit;
 
   added->previous = added->next = NULL;
+#if LLIST_NODE_KEY
+  if (ll->key_node) added->key = ll->key_node(added);
+#endif
 
   switch (position)
   {
@@ -308,6 +929,7 @@ void llist_add(llist *ll,
       if (!where) break;
       added->previous = where;
       added->next = where->next;
+      if (where->next) where->next->previous = added;
       where->next = added;
       if (ll->tail == where) ll->tail = added;
       break;
@@ -317,6 +939,8 @@ void llist_add(llist *ll,
   if (!ll->tail) ll->tail = added;
   ll->current = added;
 
+  if (ll->views) llist_view_added(ll, added);
+
 exit:
 }
 
@@ -325,6 +949,10 @@ exit:
    *
    *  @brief Deletes @p node from @p ll if it exists in the list
    *
+   *  NOTE:  The free node function sees a copy of @p node, at another
+   *         address, if @p node was relocated by <i> llist_compact </i>,
+   *         see <i> llist_set_free </i>.
+   *
    *  NOTE:  ll->current will point to ll->head on if ll->current is @p node
    *
    *  @param  ll - pointer to @a llist
@@ -345,12 +973,13 @@ void llist_remove(llist *ll, llist_node *node)
   {
     if (located == node)
     {
+      if (ll->views) llist_view_removed(ll, located);
       if (located->next) located->next->previous = located->previous;
       if (located->previous) located->previous->next = located->next;
       if (ll->head == located) ll->head = located->next;
       if (ll->tail == located) ll->tail = located->previous;
-      if (ll->free_node) ll->free_node(located);
-      else free(located);
+      if (ll->compact_next == located) ll->compact_next = located->next;
+      llist_dispose(ll, located);
       break;
     }
     located = located->next;
@@ -359,6 +988,137 @@ void llist_remove(llist *ll, llist_node *node)
   if (ll->current == located)
     ll->current = ll->head;
 
+exit:
+}
+
+  /**
+   *  @fn void llist_unlink(llist *ll, llist_node *node)
+   *
+   *  @brief Detaches @p node from @p ll in constant time, without freeing it
+   *
+   *  NOTE:  Unlike <i> llist_remove </i>, the list is not searched for @p node,
+   *         so @p node MUST be a member of @p ll.  The caller owns @p node
+   *         after this call; free it with <i> llist_release </i> if it may
+   *         have been relocated by <i> llist_compact </i>.
+   *
+   *  NOTE:  ll->current will point to ll->head on if ll->current is @p node
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  node - pointer to @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_unlink(llist *ll, llist_node *node)
+{
+  if (!ll || !node) goto exit;
+
+  if (ll->views) llist_view_removed(ll, node);
+
+  if (node->next) node->next->previous = node->previous;
+  if (node->previous) node->previous->next = node->next;
+  if (ll->head == node) ll->head = node->next;
+  if (ll->tail == node) ll->tail = node->previous;
+  if (ll->current == node) ll->current = ll->head;
+  if (ll->compact_next == node) ll->compact_next = node->next;
+
+  node->previous = node->next = NULL;
+
+exit:
+}
+
+  /**
+   *  @fn void llist_release(llist *ll, llist_node *node)
+   *
+   *  @brief Frees @p node, detached from @p ll by <i> llist_unlink </i>, as
+   *         <i> llist_remove </i> would have
+   *
+   *  NOTE:  Nodes relocated by <i> llist_compact </i> live in blocks owned by
+   *         @p ll, and MUST be freed with this function rather than by the
+   *         list free node function.
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  node - pointer to @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_release(llist *ll, llist_node *node)
+{
+  if (!ll || !node) return;
+
+  llist_dispose(ll, node);
+}
+
+  /**
+   *  @fn void llist_sort(llist *ll)
+   *
+   *  @brief Sorts @p ll in ascending order, by relinking its nodes
+   *
+   *  A stable, bottom up merge sort: nodes that compare equal keep their
+   *  relative order, and no node is copied or moved in memory.
+   *
+   *  NOTE:  @p ll compare node function must be set before calling this
+   *         function.  A lazy @p ll is fully materialized, and a compaction
+   *         in progress is finished, first.
+   *
+   *  NOTE:  ll->current will point to ll->head
+   *
+   *  @param  ll - pointer to @a llist
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_sort(llist *ll)
+{
+  llist_node *bins[64] = { NULL };
+  llist_node *node, *next, *carry;
+  int fill = 0;
+  int i;
+
+  if (!ll || !ll->cmp_node) goto exit;
+
+  while (llist_generate(ll, ll->gen_ahead));
+  if (ll->compacting) llist_compact(ll, 0);
+
+  for (node = ll->head; node; node = next)
+  {
+    next = node->next;
+    node->next = NULL;
+
+      /*
+       *  bin i holds a sorted run of 2^i nodes, older than every lower bin
+       */
+
+    carry = node;
+    for (i = 0; i < fill && bins[i]; i++)
+    {
+      carry = llist_merge(bins[i], carry, ll->cmp_node);
+      bins[i] = NULL;
+    }
+    bins[i] = carry;
+    if (i == fill) fill++;
+  }
+
+  carry = NULL;
+  for (i = 0; i < fill; i++)
+    if (bins[i]) carry = llist_merge(bins[i], carry, ll->cmp_node);
+
+  ll->head = carry;
+  ll->tail = NULL;
+  for (node = carry; node; node = node->next)
+  {
+    node->previous = ll->tail;
+    ll->tail = node;
+  }
+
+  ll->current = ll->head;
+
+  if (ll->views) llist_view_reordered(ll);
+
 exit:
 }
 
@@ -372,19 +1132,31 @@ exit:
    *  @return pointer to @a llist_node, or NULL on empty list or failure
    */
 
-llist_node *llist_head(llist *ll) { return ll ? ll->current = ll->head : NULL; }
+llist_node *llist_head(llist *ll)
+{
+  if (!ll) return NULL;
+  if (!ll->head) llist_generate(ll, ll->gen_ahead);
+  return ll->current = ll->head;
+}
 
   /**
    *  @fn llist_node *llist_tail(llist *ll)
    *
    *  @brief Returns the tail of @p ll, if any
    *
+   *  NOTE:  A lazy @p ll is fully materialized first
+   *
    *  @param  ll - pointer to @a llist
    *
    *  @return pointer to @a llist_node, or NULL on empty list or failure
    */
 
-llist_node *llist_tail(llist *ll) { return ll ? ll->current = ll->tail : NULL; }
+llist_node *llist_tail(llist *ll)
+{
+  if (!ll) return NULL;
+  while (llist_generate(ll, ll->gen_ahead));
+  return ll->current = ll->tail;
+}
 
   /**
    *  @fn llist_node *llist_current(llist *ll)
@@ -425,7 +1197,9 @@ llist_node *llist_previous(llist *ll)
 
 llist_node *llist_next(llist *ll)
 {
-  return (ll && ll->current) ? ll->current = ll->current->next : NULL;
+  if (!ll || !ll->current) return NULL;
+  if (!ll->current->next) llist_generate(ll, ll->gen_ahead);
+  return ll->current = ll->current->next;
 }
 
   /**
@@ -435,6 +1209,10 @@ llist_node *llist_next(llist *ll)
    *
    *  NOTE:  @p ll compare node function must be set before calling this function
    *
+   *  NOTE:  With a key node function set, see <i> llist_set_key </i>, and
+   *         the library built with --enable-node-key, only nodes with the
+   *         same key as @p needle are compared
+   *
    *  @param  ll - pointer to @a llist
    *  @param  needle - @a llist_node that contains payload value to search for
    *
@@ -444,14 +1222,29 @@ llist_node *llist_next(llist *ll)
 llist_node *llist_find(llist *ll, llist_node *needle)
 {
   llist_node *node = NULL;
+#if LLIST_NODE_KEY
+  uint64_t key = 0;
+#endif
 
   if (!ll || !needle) goto exit;
   if (!ll->cmp_node) goto exit;
 
+#if LLIST_NODE_KEY
+  if (ll->key_node) key = ll->key_node(needle);
+#endif
+
+  if (!ll->head) llist_generate(ll, ll->gen_ahead);
+
   node = ll->head;
   while (node)
   {
+#if LLIST_NODE_KEY
+    if ((!ll->key_node || node->key == key) && !ll->cmp_node(node, needle))
+      break;
+#else
     if (!ll->cmp_node(node, needle)) break;
+#endif
+    if (!node->next) llist_generate(ll, ll->gen_ahead);
     node = node->next;
   }
 
@@ -477,10 +1270,13 @@ llist_node *llist_find_payload(llist *ll, void *payload)
   if (!ll || !payload) goto exit;
   if (!ll->cmp_node) goto exit;
 
+  if (!ll->head) llist_generate(ll, ll->gen_ahead);
+
   node = ll->head;
   while (node)
   {
     if (node->payload == payload) break;
+    if (!node->next) llist_generate(ll, ll->gen_ahead);
     node = node->next;
   }
 
@@ -493,18 +1289,111 @@ exit:
    *
    *  @brief Creates a 'blank' @a llist_node struct
    *
+   *  NOTE:  Nodes are taken from the calling thread's node cache when
+   *         possible, see <i> llist_node_free </i>.
+   *
    *  @param payload - points to user supplied payload for new @a llist_node
    *
-   *  @return pointer to @a llist_node, or NULL if not found
+   *  @return pointer to @a llist_node, or NULL on failure
    */
 
 llist_node *llist_node_new(void *payload)
 {
-  llist_node *node = malloc(sizeof(llist_node));
-  if (node) memset(node, 0, sizeof(llist_node));
+  llist_node *node = cache_get();
+  if (!node) return NULL;
+
+  memset(node, 0, sizeof(llist_node));
 
   node->payload = payload;
 
   return node;
 }
 
+  /**
+   *  @fn void llist_node_free(llist_node *node)
+   *
+   *  @brief Frees an @a llist_node struct, but not its payload
+   *
+   *  Freed nodes are kept in a small per-thread cache for reuse by
+   *  <i> llist_node_new </i>.  Full caches are handed in batches to a global
+   *  depot, so nodes freed by one thread are reused by another without going
+   *  back through malloc.
+   *
+   *  NOTE:  User supplied free node functions should call this, instead of
+   *         <i> free </i>, to release the node itself.  Any node allocated
+   *         with <i> malloc </i> may be passed, @p node need not come from
+   *         <i> llist_node_new </i>.
+   *
+   *  @param node - pointer to @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_node_free(llist_node *node)
+{
+  if (node) cache_put(node);
+}
+
+  /**
+   *  @fn void llist_node_cache_stats_get(llist_node_cache_stats *stats)
+   *
+   *  @brief Reports node cache counters
+   *
+   *  NOTE:  Counters of other threads are included as of their last depot
+   *         exchange, or their exit.
+   *
+   *  @param stats - pointer to @a llist_node_cache_stats to fill in
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_node_cache_stats_get(llist_node_cache_stats *stats)
+{
+  if (!stats) return;
+
+  pthread_mutex_lock(&depot_lock);
+  *stats = depot_stats;
+  pthread_mutex_unlock(&depot_lock);
+
+  stats->allocs += cache_stats.allocs;
+  stats->hits += cache_stats.hits;
+  stats->frees += cache_stats.frees;
+  stats->depot_gets += cache_stats.depot_gets;
+  stats->depot_puts += cache_stats.depot_puts;
+}
+
+  /**
+   *  @fn void llist_node_cache_purge(void)
+   *
+   *  @brief Returns cached nodes of the calling thread, and of the global
+   *         depot, to the system allocator
+   *
+   *  @par Parameters
+   *       None.
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_node_cache_purge(void)
+{
+  llist_magazine mag;
+
+  magazine_release(&cache_loaded);
+  magazine_release(&cache_previous);
+
+  pthread_mutex_lock(&depot_lock);
+
+  while (depot)
+  {
+    mag.top = depot;
+    depot = depot->previous;
+    magazine_release(&mag);
+  }
+
+  depot_count = 0;
+
+  pthread_mutex_unlock(&depot_lock);
+}
@@ -0,0 +1,485 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or (at your
+ *  option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file llist_lru.c
+ * @brief Source code file for least recently used cache built on @a llist
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "llist_lru_hooks.h"
+
+#define LLIST_LRU_BUCKETS 64
+
+  /**
+   *  @struct llist_lru_entry
+   *  @brief hash table entry, maps a key to its node in the recency list
+   */
+
+struct llist_lru_entry
+{
+  llist_node *node;               /**<  cached node  */
+  unsigned long hash;             /**<  hash of @a node key  */
+  size_t size;                    /**<  bytes charged to @a node  */
+  struct llist_lru_entry *next;   /**<  next entry in hash bucket  */
+};
+
+    /*
+     * private functions
+     */
+
+static unsigned long lru_hash(llist_lru *lru, llist_node *node)
+{
+  if (lru->hash_node) return lru->hash_node(node);
+  if (lru->ll->key_node) return (unsigned long)lru->ll->key_node(node);
+  return 0;
+}
+
+static int lru_grow(llist_lru *lru)
+{
+  llist_lru_entry **buckets = NULL;
+  llist_lru_entry *entry, *next;
+  size_t nbuckets;
+  size_t i;
+
+  nbuckets = lru->nbuckets * 2;
+
+  if (!(buckets = calloc(nbuckets, sizeof(llist_lru_entry *)))) return 0;
+
+  for (i = 0; i < lru->nbuckets; i++)
+  {
+    for (entry = lru->buckets[i]; entry; entry = next)
+    {
+      next = entry->next;
+      entry->next = buckets[entry->hash % nbuckets];
+      buckets[entry->hash % nbuckets] = entry;
+    }
+  }
+
+  free(lru->buckets);
+  lru->buckets = buckets;
+  lru->nbuckets = nbuckets;
+
+  return 1;
+}
+
+static llist_lru_entry **lru_lookup_node(llist_lru *lru, llist_node *node)
+{
+  llist_lru_entry **entry;
+
+  entry = &lru->buckets[lru_hash(lru, node) % lru->nbuckets];
+  while (*entry && (*entry)->node != node) entry = &(*entry)->next;
+
+  return *entry ? entry : NULL;
+}
+
+    /*
+     *  released through llist_release(), so that nodes relocated by
+     *  llist_compact() go back to their block
+     */
+
+static void lru_discard(llist_lru *lru,
+                        llist_lru_entry **entry,
+                        llist_free_node free_func)
+{
+  llist_lru_entry *found = *entry;
+  llist_free_node list_free;
+
+  *entry = found->next;
+
+  llist_unlink(lru->ll, found->node);
+
+  list_free = lru->ll->free_node;
+  lru->ll->free_node = free_func;
+  llist_release(lru->ll, found->node);
+  lru->ll->free_node = list_free;
+
+  lru->count--;
+  lru->bytes -= found->size;
+
+  free(found);
+}
+
+static int lru_over(llist_lru *lru)
+{
+  if (lru->max_count && lru->count > lru->max_count) return 1;
+  if (lru->max_bytes && lru->bytes > lru->max_bytes) return 1;
+  return 0;
+}
+
+    /*
+     * public functions
+     */
+
+  /**
+   *  @fn llist_lru *llist_lru_new(size_t max_count, size_t max_bytes)
+   *
+   *  @brief Create a least recently used cache
+   *
+   *  NOTE:  @p max_bytes is only honored when a size function is set with
+   *         <i> llist_lru_set_size </i>.
+   *
+   *  @param max_count - maximum number of cached nodes, 0 for no limit
+   *  @param max_bytes - maximum bytes charged to cached nodes, 0 for no limit
+   *
+   *  @return pointer to new @a llist_lru, or NULL on failure
+   */
+
+llist_lru *llist_lru_new(size_t max_count, size_t max_bytes)
+{
+  llist_lru *lru = NULL;
+
+  if (!(lru = malloc(sizeof(llist_lru)))) goto exit;
+  memset(lru, 0, sizeof(llist_lru));
+
+  lru->max_count = max_count;
+  lru->max_bytes = max_bytes;
+  lru->nbuckets = LLIST_LRU_BUCKETS;
+
+  lru->ll = llist_new();
+  lru->buckets = calloc(lru->nbuckets, sizeof(llist_lru_entry *));
+
+  if (lru->ll) lru->ll->lru = lru;
+
+  if (!lru->ll || !lru->buckets)
+  {
+    llist_free(lru->ll);
+    free(lru->buckets);
+    free(lru);
+    lru = NULL;
+  }
+
+exit:
+  return lru;
+}
+
+  /**
+   *  @fn void llist_lru_free(llist_lru *lru)
+   *
+   *  @brief Frees all memory allocated to @p lru
+   *
+   *  NOTE:  Cached nodes are freed with the free function of @p lru->ll, the
+   *         eviction function is not called.
+   *
+   *  @param lru - pointer to @a llist_lru struct
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_free(llist_lru *lru)
+{
+  llist_lru_entry *entry, *next;
+  size_t i;
+
+  if (!lru) goto exit;
+
+  for (i = 0; i < lru->nbuckets; i++)
+  {
+    for (entry = lru->buckets[i]; entry; entry = next)
+    {
+      next = entry->next;
+      free(entry);
+    }
+  }
+
+  free(lru->buckets);
+  llist_free(lru->ll);
+  free(lru);
+
+exit:
+}
+
+  /**
+   *  @fn void llist_lru_set_hash(llist_lru *lru, llist_hash_node hash_func)
+   *
+   *  @brief Sets node key hash function in @p lru
+   *
+   *  NOTE:  Without a hash function, the key node function of lru->ll is
+   *         used if set, see <i> llist_set_key </i>, otherwise every lookup
+   *         is a linear scan.  Set it before the first <i> llist_lru_put </i>.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  hash_func - pointer to function that hashes a @a llist_node key
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_set_hash(llist_lru *lru, llist_hash_node hash_func)
+{
+  if (lru) lru->hash_node = hash_func;
+}
+
+  /**
+   *  @fn void llist_lru_set_size(llist_lru *lru, llist_size_node size_func)
+   *
+   *  @brief Sets node size function in @p lru, used for the byte capacity
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  size_func - pointer to function that sizes a @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_set_size(llist_lru *lru, llist_size_node size_func)
+{
+  if (lru) lru->size_node = size_func;
+}
+
+  /**
+   *  @fn void llist_lru_set_evict(llist_lru *lru, llist_free_node evict_func)
+   *
+   *  @brief Sets eviction function in @p lru
+   *
+   *  NOTE:  @p evict_func takes ownership of the evicted node, exactly like
+   *         a free node function.  When it is not set, evicted nodes are
+   *         freed with the free function of @p lru->ll.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  evict_func - pointer to function that receives evicted nodes
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_set_evict(llist_lru *lru, llist_free_node evict_func)
+{
+  if (lru) lru->evict_node = evict_func;
+}
+
+  /**
+   *  @fn llist_node *llist_lru_get(llist_lru *lru, llist_node *needle)
+   *
+   *  @brief Looks up the cached node with the same key as @p needle
+   *
+   *  NOTE:  On a hit the node becomes the most recently used node.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  needle - @a llist_node that contains key to search for
+   *
+   *  @return pointer to @a llist_node, or NULL if not cached
+   */
+
+llist_node *llist_lru_get(llist_lru *lru, llist_node *needle)
+{
+  llist_lru_entry *entry = NULL;
+  unsigned long hash;
+
+  if (!lru || !needle) goto exit;
+  if (!lru->ll->cmp_node) goto exit;
+
+  hash = lru_hash(lru, needle);
+
+  for (entry = lru->buckets[hash % lru->nbuckets]; entry; entry = entry->next)
+    if (entry->hash == hash && !lru->ll->cmp_node(entry->node, needle)) break;
+
+  if (!entry)
+  {
+    lru->misses++;
+    goto exit;
+  }
+
+  lru->hits++;
+  llist_lru_touch(lru, entry->node);
+
+exit:
+  return entry ? entry->node : NULL;
+}
+
+  /**
+   *  @fn llist_node *llist_lru_put(llist_lru *lru, llist_node *node)
+   *
+   *  @brief Caches @p node as the most recently used node
+   *
+   *  NOTE:  Memory ownership of @p node follows <i> llist_add </i>.  A cached
+   *         node with the same key is replaced and freed.  Least recently used
+   *         nodes are then evicted until @p lru is within capacity, but the
+   *         new node itself is never evicted.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  node - pointer to @a llist_node to cache
+   *
+   *  @return pointer to cached @a llist_node, or NULL on failure
+   */
+
+llist_node *llist_lru_put(llist_lru *lru, llist_node *node)
+{
+  llist_lru_entry **found = NULL;
+  llist_lru_entry *entry = NULL;
+  llist_node *head = NULL;
+  llist_node *added = NULL;
+  unsigned long hash;
+
+  if (!lru || !node) goto exit;
+  if (!lru->ll->cmp_node) goto exit;
+
+  if (!(entry = malloc(sizeof(llist_lru_entry)))) goto exit;
+
+  hash = lru_hash(lru, node);
+
+  found = &lru->buckets[hash % lru->nbuckets];
+  while (*found)
+  {
+    if ((*found)->hash == hash && !lru->ll->cmp_node((*found)->node, node))
+    {
+      lru_discard(lru, found, lru->ll->free_node);
+      break;
+    }
+    found = &(*found)->next;
+  }
+
+  head = lru->ll->head;
+  llist_add(lru->ll, llist_position_head, NULL, node);
+
+  if ((added = lru->ll->head) == head)
+  {
+    free(entry);
+    added = NULL;
+    goto exit;
+  }
+
+  if (lru->count >= lru->nbuckets) lru_grow(lru);
+
+  entry->node = added;
+  entry->hash = hash;
+  entry->size = lru->size_node ? lru->size_node(added) : 0;
+  entry->next = lru->buckets[hash % lru->nbuckets];
+  lru->buckets[hash % lru->nbuckets] = entry;
+
+  lru->count++;
+  lru->bytes += entry->size;
+
+  while (lru_over(lru) && lru->ll->tail != added)
+    if (!llist_lru_evict(lru)) break;
+
+exit:
+  return added;
+}
+
+  /**
+   *  @fn void llist_lru_touch(llist_lru *lru, llist_node *node)
+   *
+   *  @brief Makes @p node the most recently used node, in constant time
+   *
+   *  NOTE:  @p node MUST be cached in @p lru.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  node - pointer to cached @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_touch(llist_lru *lru, llist_node *node)
+{
+  llist_dup_node dup_func;
+
+  if (!lru || !node) goto exit;
+  if (lru->ll->head == node) goto exit;
+
+  dup_func = lru->ll->dup_node;
+
+  llist_unlink(lru->ll, node);
+  lru->ll->dup_node = NULL;
+  llist_add(lru->ll, llist_position_head, NULL, node);
+  lru->ll->dup_node = dup_func;
+
+exit:
+}
+
+  /**
+   *  @fn void llist_lru_remove(llist_lru *lru, llist_node *node)
+   *
+   *  @brief Deletes @p node from @p lru if it is cached
+   *
+   *  NOTE:  @p node is freed with the free function of @p lru->ll.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  node - pointer to cached @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_remove(llist_lru *lru, llist_node *node)
+{
+  llist_lru_entry **entry = NULL;
+
+  if (!lru || !node) goto exit;
+
+  if ((entry = lru_lookup_node(lru, node)))
+    lru_discard(lru, entry, lru->ll->free_node);
+
+exit:
+}
+
+  /**
+   *  @fn int llist_lru_evict(llist_lru *lru)
+   *
+   *  @brief Evicts the least recently used node from @p lru
+   *
+   *  NOTE:  The evicted node is passed to the eviction function, when set,
+   *         otherwise it is freed with the free function of @p lru->ll.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *
+   *  @return 1 if a node was evicted, 0 if @p lru is empty
+   */
+
+int llist_lru_evict(llist_lru *lru)
+{
+  llist_lru_entry **entry = NULL;
+
+  if (!lru || !lru->ll->tail) return 0;
+
+  if (!(entry = lru_lookup_node(lru, lru->ll->tail))) return 0;
+
+  lru_discard(lru,
+              entry,
+              lru->evict_node ? lru->evict_node : lru->ll->free_node);
+  lru->evictions++;
+
+  return 1;
+}
+
+  /**
+   *  @fn void llist_lru_moved(llist_lru *lru, llist_node *from, llist_node *to)
+   *
+   *  @brief Follows a cached node relocated from @p from to @p to by
+   *         <i> llist_compact </i>
+   *
+   *  NOTE:  Entries are hashed by key, not by address, so only the node
+   *         pointer of the entry changes.
+   *
+   *  @param  lru - pointer to @a llist_lru
+   *  @param  from - old address of the @a llist_node
+   *  @param  to - new address of the @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_lru_moved(llist_lru *lru, llist_node *from, llist_node *to)
+{
+  llist_lru_entry **entry;
+
+  if ((entry = lru_lookup_node(lru, from))) (*entry)->node = to;
+}
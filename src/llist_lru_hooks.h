@@ -0,0 +1,31 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_lru_hooks.h
+ *  @brief Private header file for the @a llist_lru hooks, called by the
+ *         @a llist functions on the recency list.  Not installed.
+ */
+
+#ifndef LLIST_LRU_HOOKS_H
+#define LLIST_LRU_HOOKS_H
+
+#include "llist_lru.h"
+
+void llist_lru_moved(llist_lru *lru, llist_node *from, llist_node *to);
+
+#endif //LLIST_LRU_HOOKS_H
@@ -0,0 +1,355 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or (at your
+ *  option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file llist_queue.c
+ * @brief Source code file for bounded, blocking producer/consumer queue built
+ *        on @a llist
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_EVENTFD_H
+#include <sys/eventfd.h>
+#endif
+
+#include "llist_queue.h"
+
+    /*
+     * private functions
+     */
+
+static struct timespec *queue_deadline(struct timespec *ts, long timeout)
+{
+  if (timeout < 0) return NULL;
+
+  clock_gettime(CLOCK_MONOTONIC, ts);
+
+  ts->tv_sec += timeout / 1000;
+  ts->tv_nsec += (timeout % 1000) * 1000000L;
+  if (ts->tv_nsec >= 1000000000L)
+  {
+    ts->tv_sec++;
+    ts->tv_nsec -= 1000000000L;
+  }
+
+  return ts;
+}
+
+static int queue_wait(llist_queue *q,
+                      pthread_cond_t *cond,
+                      long timeout,
+                      struct timespec *deadline)
+{
+  if (!timeout) return 0;
+  if (!deadline) return !pthread_cond_wait(cond, &q->lock);
+  return pthread_cond_timedwait(cond, &q->lock, deadline) != ETIMEDOUT;
+}
+
+static void queue_signal(llist_queue *q)
+{
+  uint64_t one = 1;
+
+  if (q->efd >= 0 && write(q->efd, &one, sizeof(one)) < 0) return;
+}
+
+    /*
+     * public functions
+     */
+
+  /**
+   *  @fn llist_queue *llist_queue_new(size_t capacity)
+   *
+   *  @brief Create a bounded, thread safe queue
+   *
+   *  @param capacity - maximum number of queued nodes, 0 for no limit
+   *
+   *  @return pointer to new @a llist_queue, or NULL on failure
+   */
+
+llist_queue *llist_queue_new(size_t capacity)
+{
+  llist_queue *q = NULL;
+  pthread_condattr_t attr;
+
+  if (!(q = malloc(sizeof(llist_queue)))) goto exit;
+  memset(q, 0, sizeof(llist_queue));
+
+  if (!(q->ll = llist_new()))
+  {
+    free(q);
+    q = NULL;
+    goto exit;
+  }
+
+  q->capacity = capacity;
+  q->efd = -1;
+
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+  pthread_mutex_init(&q->lock, NULL);
+  pthread_cond_init(&q->not_empty, &attr);
+  pthread_cond_init(&q->not_full, &attr);
+
+  pthread_condattr_destroy(&attr);
+
+exit:
+  return q;
+}
+
+  /**
+   *  @fn void llist_queue_free(llist_queue *q)
+   *
+   *  @brief Frees all memory allocated to @p q, including queued nodes
+   *
+   *  NOTE:  No thread may be using @p q, see <i> llist_queue_close </i>
+   *
+   *  @param q - pointer to @a llist_queue struct
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_queue_free(llist_queue *q)
+{
+  if (!q) goto exit;
+
+  if (q->efd >= 0) close(q->efd);
+
+  pthread_cond_destroy(&q->not_full);
+  pthread_cond_destroy(&q->not_empty);
+  pthread_mutex_destroy(&q->lock);
+
+  llist_free(q->ll);
+  free(q);
+
+exit:
+}
+
+  /**
+   *  @fn int llist_queue_eventfd(llist_queue *q)
+   *
+   *  @brief Returns an eventfd that becomes readable when @p q has nodes
+   *
+   *  The eventfd is created on the first call and is signalled when @p q goes
+   *  from empty to non-empty, and on <i> llist_queue_close </i>, so it can be
+   *  added to an epoll set.  When it is readable, read it to reset it, then
+   *  pop with a timeout of 0 until @p q is empty.  Stopping before the queue
+   *  is empty may miss a wakeup.
+   *
+   *  @param q - pointer to @a llist_queue struct
+   *
+   *  @return eventfd file descriptor, or -1 on failure or if unsupported
+   */
+
+int llist_queue_eventfd(llist_queue *q)
+{
+  int efd = -1;
+
+  if (!q) goto exit;
+
+  pthread_mutex_lock(&q->lock);
+
+#ifdef HAVE_SYS_EVENTFD_H
+  if (q->efd < 0)
+    q->efd = eventfd(q->count || q->closed, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+
+  efd = q->efd;
+
+  pthread_mutex_unlock(&q->lock);
+
+exit:
+  return efd;
+}
+
+  /**
+   *  @fn void llist_queue_close(llist_queue *q)
+   *
+   *  @brief Closes @p q, waking every blocked producer and consumer
+   *
+   *  NOTE:  Pushes fail after @p q is closed, pops return the nodes still
+   *         queued and then fail without waiting.
+   *
+   *  @param q - pointer to @a llist_queue struct
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_queue_close(llist_queue *q)
+{
+  if (!q) return;
+
+  pthread_mutex_lock(&q->lock);
+
+  q->closed = 1;
+  pthread_cond_broadcast(&q->not_empty);
+  pthread_cond_broadcast(&q->not_full);
+  queue_signal(q);
+
+  pthread_mutex_unlock(&q->lock);
+}
+
+  /**
+   *  @fn int llist_queue_push(llist_queue *q, llist_node *node, long timeout)
+   *
+   *  @brief Appends @p node to @p q, waiting for room when @p q is full
+   *
+   *  NOTE:  @p q takes ownership of @p node on success, it is not duplicated
+   *
+   *  @param q - pointer to @a llist_queue struct
+   *  @param node - pointer to @a llist_node to queue
+   *  @param timeout - milliseconds to wait for room, 0 to not wait, negative
+   *                   to wait forever
+   *
+   *  @return 1 on success, 0 if @p q is full after @p timeout, or closed
+   */
+
+int llist_queue_push(llist_queue *q, llist_node *node, long timeout)
+{
+  struct timespec ts, *deadline;
+  llist_dup_node dup_func;
+  int pushed = 0;
+
+  if (!q || !node) return 0;
+
+  deadline = queue_deadline(&ts, timeout);
+
+  pthread_mutex_lock(&q->lock);
+
+  while (!q->closed && q->capacity && q->count >= q->capacity)
+    if (!queue_wait(q, &q->not_full, timeout, deadline)) break;
+
+  if (!q->closed && (!q->capacity || q->count < q->capacity))
+  {
+    dup_func = q->ll->dup_node;
+    q->ll->dup_node = NULL;
+    llist_add(q->ll, llist_position_tail, NULL, node);
+    q->ll->dup_node = dup_func;
+
+    if (!q->count++) queue_signal(q);
+    pthread_cond_signal(&q->not_empty);
+    pushed = 1;
+  }
+
+  pthread_mutex_unlock(&q->lock);
+
+  return pushed;
+}
+
+  /**
+   *  @fn llist_node *llist_queue_pop(llist_queue *q, long timeout)
+   *
+   *  @brief Removes the oldest node from @p q, waiting when @p q is empty
+   *
+   *  NOTE:  The caller owns the returned node
+   *
+   *  @param q - pointer to @a llist_queue struct
+   *  @param timeout - milliseconds to wait for a node, 0 to not wait,
+   *                   negative to wait forever
+   *
+   *  @return pointer to @a llist_node, or NULL if @p q is empty after
+   *          @p timeout, or closed and drained
+   */
+
+llist_node *llist_queue_pop(llist_queue *q, long timeout)
+{
+  llist batch;
+
+  memset(&batch, 0, sizeof(llist));
+
+  llist_queue_pop_batch(q, &batch, 1, timeout);
+
+  return batch.head;
+}
+
+  /**
+   *  @fn size_t llist_queue_pop_batch(llist_queue *q,
+   *                                   llist *batch,
+   *                                   size_t max,
+   *                                   long timeout)
+   *
+   *  @brief Moves up to @p max of the oldest nodes of @p q to the tail of
+   *         @p batch, under a single lock acquisition
+   *
+   *  Waits, as <i> llist_queue_pop </i> does, only until at least one node
+   *  is available.
+   *
+   *  @param q - pointer to @a llist_queue struct
+   *  @param batch - pointer to @a llist that receives the nodes
+   *  @param max - maximum number of nodes to move
+   *  @param timeout - milliseconds to wait for a node, 0 to not wait,
+   *                   negative to wait forever
+   *
+   *  @return number of nodes moved
+   */
+
+size_t llist_queue_pop_batch(llist_queue *q,
+                             llist *batch,
+                             size_t max,
+                             long timeout)
+{
+  struct timespec ts, *deadline;
+  llist_node *first, *last;
+  size_t count = 0;
+
+  if (!q || !batch || !max) return 0;
+
+  deadline = queue_deadline(&ts, timeout);
+
+  pthread_mutex_lock(&q->lock);
+
+  while (!q->count && !q->closed)
+    if (!queue_wait(q, &q->not_empty, timeout, deadline)) break;
+
+  if (!q->count) goto exit;
+
+  first = last = q->ll->head;
+  for (count = 1; count < max && last->next; count++) last = last->next;
+
+  q->ll->head = last->next;
+  if (q->ll->head) q->ll->head->previous = NULL;
+  else q->ll->tail = NULL;
+  q->ll->current = q->ll->head;
+  q->count -= count;
+
+  last->next = NULL;
+
+  first->previous = batch->tail;
+  if (batch->tail) batch->tail->next = first;
+  else batch->head = first;
+  batch->tail = last;
+
+  if (count > 1) pthread_cond_broadcast(&q->not_full);
+  else pthread_cond_signal(&q->not_full);
+
+exit:
+  pthread_mutex_unlock(&q->lock);
+
+  return count;
+}
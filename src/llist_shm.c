@@ -0,0 +1,659 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or (at your
+ *  option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file llist_shm.c
+ * @brief Source code file for process shared doubly linked lists, kept in a
+ *        shared memory segment
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "llist_shm.h"
+
+#define SHM_ALIGN 16
+#define SHM_MIN_BLOCK 32
+
+#define SHM_PTR(shm, off) \
+  ((off) ? (void *)((char *)(shm)->header + (off)) : NULL)
+#define SHM_OFF(shm, ptr) \
+  ((ptr) ? (llist_shm_off)((char *)(ptr) - (char *)(shm)->header) : 0)
+
+    /*
+     * private functions
+     */
+
+static llist_shm_off shm_alloc(llist_shm *shm, size_t size)
+{
+  llist_shm_header *h = shm->header;
+  llist_shm_off off;
+  size_t need = size + sizeof(size_t);
+  size_t cls;
+
+  for (cls = 0; cls < LLIST_SHM_CLASSES; cls++)
+    if (((size_t)SHM_MIN_BLOCK << cls) >= need) break;
+
+  if (cls == LLIST_SHM_CLASSES) return 0;
+
+  if ((off = h->free_blocks[cls]))
+  {
+    h->free_blocks[cls] = *(llist_shm_off *)SHM_PTR(shm, off + sizeof(size_t));
+  }
+  else
+  {
+    if (h->brk + ((size_t)SHM_MIN_BLOCK << cls) > shm->size) return 0;
+    off = h->brk;
+    h->brk += (size_t)SHM_MIN_BLOCK << cls;
+  }
+
+  *(size_t *)SHM_PTR(shm, off) = cls;
+
+  return off + sizeof(size_t);
+}
+
+static void shm_release(llist_shm *shm, llist_shm_off off)
+{
+  llist_shm_header *h = shm->header;
+  size_t cls;
+
+  off -= sizeof(size_t);
+  cls = *(size_t *)SHM_PTR(shm, off);
+
+  *(llist_shm_off *)SHM_PTR(shm, off + sizeof(size_t)) = h->free_blocks[cls];
+  h->free_blocks[cls] = off;
+}
+
+static llist_shm *shm_map(int fd, size_t size)
+{
+  llist_shm *shm = NULL;
+  void *base;
+
+  base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) goto exit;
+
+  if (!(shm = malloc(sizeof(llist_shm))))
+  {
+    munmap(base, size);
+    goto exit;
+  }
+
+  shm->header = (llist_shm_header *)base;
+  shm->size = size;
+  shm->fd = fd;
+
+exit:
+  return shm;
+}
+
+    /*
+     * public functions
+     */
+
+  /**
+   *  @fn llist_shm *llist_shm_create(const char *name, size_t size)
+   *
+   *  @brief Creates a shared memory segment of @p size bytes, holding an
+   *         empty list
+   *
+   *  When @p name is given the segment is created with <i> shm_open </i>
+   *  and other processes attach with <i> llist_shm_open </i>.  Otherwise an
+   *  anonymous <i> memfd_create </i> segment is made, which other processes
+   *  attach with <i> llist_shm_attach </i> on an inherited or passed @p fd.
+   *
+   *  @param name - POSIX shared memory name, "/something", or NULL
+   *  @param size - segment size in bytes, bounds the total of all nodes
+   *
+   *  @return pointer to new @a llist_shm, or NULL on failure
+   */
+
+llist_shm *llist_shm_create(const char *name, size_t size)
+{
+  llist_shm *shm = NULL;
+  llist_shm_header *h;
+  pthread_rwlockattr_t attr;
+  int fd = -1;
+
+  if (size < sizeof(llist_shm_header) + SHM_MIN_BLOCK) goto exit;
+
+  if (name) fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+#ifdef HAVE_MEMFD_CREATE
+  else fd = memfd_create("llist", 0);
+#endif
+
+  if (fd < 0) goto exit;
+
+  if (ftruncate(fd, size) < 0 || !(shm = shm_map(fd, size)))
+  {
+    if (name) shm_unlink(name);
+    close(fd);
+    goto exit;
+  }
+
+  h = shm->header;
+  memset(h, 0, sizeof(llist_shm_header));
+
+  pthread_rwlockattr_init(&attr);
+  pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  pthread_rwlock_init(&h->lock, &attr);
+  pthread_rwlockattr_destroy(&attr);
+
+  h->size = size;
+  h->brk = (sizeof(llist_shm_header) + SHM_ALIGN - 1) & ~(SHM_ALIGN - 1);
+  h->magic = LLIST_SHM_MAGIC;
+
+exit:
+  return shm;
+}
+
+  /**
+   *  @fn llist_shm *llist_shm_open(const char *name)
+   *
+   *  @brief Attaches to the list in the named shared memory segment
+   *
+   *  @param name - POSIX shared memory name given to <i> llist_shm_create </i>
+   *
+   *  @return pointer to new @a llist_shm, or NULL on failure
+   */
+
+llist_shm *llist_shm_open(const char *name)
+{
+  llist_shm *shm = NULL;
+  int fd;
+
+  if (!name) goto exit;
+
+  if ((fd = shm_open(name, O_RDWR, 0)) < 0) goto exit;
+
+  shm = llist_shm_attach(fd);
+
+  close(fd);
+
+exit:
+  return shm;
+}
+
+  /**
+   *  @fn llist_shm *llist_shm_attach(int fd)
+   *
+   *  @brief Attaches to the list in the shared memory segment open on @p fd
+   *
+   *  NOTE:  @p fd is duplicated, the caller still owns it
+   *
+   *  @param fd - file descriptor of a segment made by <i> llist_shm_create </i>
+   *
+   *  @return pointer to new @a llist_shm, or NULL on failure
+   */
+
+llist_shm *llist_shm_attach(int fd)
+{
+  llist_shm *shm = NULL;
+  struct stat st;
+
+  if (fstat(fd, &st) < 0) goto exit;
+  if ((size_t)st.st_size < sizeof(llist_shm_header)) goto exit;
+
+  if ((fd = dup(fd)) < 0) goto exit;
+
+  if (!(shm = shm_map(fd, st.st_size)))
+  {
+    close(fd);
+    goto exit;
+  }
+
+  if (shm->header->magic != LLIST_SHM_MAGIC ||
+      shm->header->size != shm->size)
+  {
+    llist_shm_close(shm);
+    shm = NULL;
+  }
+
+exit:
+  return shm;
+}
+
+  /**
+   *  @fn void llist_shm_close(llist_shm *shm)
+   *
+   *  @brief Detaches this process from @p shm and frees the handle
+   *
+   *  NOTE:  The segment itself lives on until every process has closed it,
+   *         and, for a named segment, <i> llist_shm_unlink </i> is called.
+   *
+   *  @param shm - pointer to @a llist_shm struct
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_shm_close(llist_shm *shm)
+{
+  if (!shm) return;
+
+  munmap(shm->header, shm->size);
+  close(shm->fd);
+  free(shm);
+}
+
+  /**
+   *  @fn int llist_shm_unlink(const char *name)
+   *
+   *  @brief Removes the name of a shared memory segment
+   *
+   *  @param name - POSIX shared memory name given to <i> llist_shm_create </i>
+   *
+   *  @return 0 on success, -1 on failure
+   */
+
+int llist_shm_unlink(const char *name)
+{
+  return name ? shm_unlink(name) : -1;
+}
+
+  /**
+   *  @fn void llist_shm_lock(llist_shm *shm, int write)
+   *
+   *  @brief Locks the list in @p shm, across all attached processes
+   *
+   *  Any number of readers may hold the lock at once.  Hold a read lock
+   *  around traversal with <i> llist_shm_head </i>, <i> llist_shm_next </i>,
+   *  <i> llist_shm_find </i>, etc.  <i> llist_shm_add </i>,
+   *  <i> llist_shm_remove </i> and <i> llist_shm_import </i> take the write
+   *  lock themselves, and must not be called with the lock held.  To find
+   *  a node and then add next to it or remove it, hold the write lock across
+   *  both steps and use <i> llist_shm_add_locked </i> or
+   *  <i> llist_shm_remove_locked </i>, so that no other process can remove
+   *  the node in between.
+   *
+   *  @param shm - pointer to @a llist_shm struct
+   *  @param write - non-zero for exclusive access, 0 for shared access
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_shm_lock(llist_shm *shm, int write)
+{
+  if (!shm) return;
+
+  if (write) pthread_rwlock_wrlock(&shm->header->lock);
+  else pthread_rwlock_rdlock(&shm->header->lock);
+}
+
+  /**
+   *  @fn void llist_shm_unlock(llist_shm *shm)
+   *
+   *  @brief Releases a lock taken by <i> llist_shm_lock </i>
+   *
+   *  @param shm - pointer to @a llist_shm struct
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_shm_unlock(llist_shm *shm)
+{
+  if (shm) pthread_rwlock_unlock(&shm->header->lock);
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_add(llist_shm *shm,
+   *                                    llist_position position,
+   *                                    llist_shm_node *where,
+   *                                    const void *payload,
+   *                                    size_t size)
+   *
+   *  @brief Copies @p size bytes of @p payload into a new node of @p shm
+   *
+   *  NOTE:  The payload is copied as raw bytes, so it must not contain
+   *         pointers.
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  position - llist_position value, fine tunes insertion point
+   *  @param  where - @a llist_shm_node to use as insertion reference, NULL
+   *                  for head (before) or tail (after)
+   *  @param  payload - bytes to copy into the node
+   *  @param  size - number of bytes in @p payload
+   *
+   *  @return pointer to new @a llist_shm_node, or NULL if @p shm is full
+   */
+
+llist_shm_node *llist_shm_add(llist_shm *shm,
+                              llist_position position,
+                              llist_shm_node *where,
+                              const void *payload,
+                              size_t size)
+{
+  llist_shm_node *node = NULL;
+
+  if (!shm || (size && !payload)) goto exit;
+
+  pthread_rwlock_wrlock(&shm->header->lock);
+  node = llist_shm_add_locked(shm, position, where, payload, size);
+  pthread_rwlock_unlock(&shm->header->lock);
+
+exit:
+  return node;
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_add_locked(llist_shm *shm,
+   *                                           llist_position position,
+   *                                           llist_shm_node *where,
+   *                                           const void *payload,
+   *                                           size_t size)
+   *
+   *  @brief Same as <i> llist_shm_add </i>, for a caller already holding the
+   *         write lock of @p shm
+   *
+   *  NOTE:  The write lock, see <i> llist_shm_lock </i>, MUST be held.
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  position - llist_position value, fine tunes insertion point
+   *  @param  where - @a llist_shm_node to use as insertion reference, NULL
+   *                  for head (before) or tail (after)
+   *  @param  payload - bytes to copy into the node
+   *  @param  size - number of bytes in @p payload
+   *
+   *  @return pointer to new @a llist_shm_node, or NULL if @p shm is full
+   */
+
+llist_shm_node *llist_shm_add_locked(llist_shm *shm,
+                                     llist_position position,
+                                     llist_shm_node *where,
+                                     const void *payload,
+                                     size_t size)
+{
+  llist_shm_header *h;
+  llist_shm_node *node = NULL;
+  llist_shm_node *neighbor;
+  llist_shm_off off;
+
+  if (!shm || (size && !payload)) goto exit;
+
+  h = shm->header;
+
+  if (!(off = shm_alloc(shm, sizeof(llist_shm_node) + size))) goto exit;
+
+  node = SHM_PTR(shm, off);
+  node->size = size;
+  if (size) memcpy(node + 1, payload, size);
+
+  if (position == llist_position_before && !where)
+    position = llist_position_head;
+  if (position == llist_position_after && !where)
+    position = llist_position_tail;
+
+  switch (position)
+  {
+    case llist_position_head:
+      node->previous = 0;
+      node->next = h->head;
+      if (h->head) ((llist_shm_node *)SHM_PTR(shm, h->head))->previous = off;
+      h->head = off;
+      if (!h->tail) h->tail = off;
+      break;
+    case llist_position_tail:
+      node->previous = h->tail;
+      node->next = 0;
+      if (h->tail) ((llist_shm_node *)SHM_PTR(shm, h->tail))->next = off;
+      h->tail = off;
+      if (!h->head) h->head = off;
+      break;
+    case llist_position_before:
+      node->previous = where->previous;
+      node->next = SHM_OFF(shm, where);
+      if ((neighbor = SHM_PTR(shm, where->previous))) neighbor->next = off;
+      else h->head = off;
+      where->previous = off;
+      break;
+    case llist_position_after:
+      node->previous = SHM_OFF(shm, where);
+      node->next = where->next;
+      if ((neighbor = SHM_PTR(shm, where->next))) neighbor->previous = off;
+      else h->tail = off;
+      where->next = off;
+      break;
+  }
+
+  h->count++;
+
+exit:
+  return node;
+}
+
+  /**
+   *  @fn void llist_shm_remove(llist_shm *shm, llist_shm_node *node)
+   *
+   *  @brief Deletes @p node from @p shm, in constant time
+   *
+   *  NOTE:  @p node MUST be a member of @p shm
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  node - pointer to @a llist_shm_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_shm_remove(llist_shm *shm, llist_shm_node *node)
+{
+  if (!shm || !node) return;
+
+  pthread_rwlock_wrlock(&shm->header->lock);
+  llist_shm_remove_locked(shm, node);
+  pthread_rwlock_unlock(&shm->header->lock);
+}
+
+  /**
+   *  @fn void llist_shm_remove_locked(llist_shm *shm, llist_shm_node *node)
+   *
+   *  @brief Same as <i> llist_shm_remove </i>, for a caller already holding
+   *         the write lock of @p shm
+   *
+   *  NOTE:  The write lock, see <i> llist_shm_lock </i>, MUST be held, and
+   *         @p node MUST have been found while holding it.
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  node - pointer to @a llist_shm_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_shm_remove_locked(llist_shm *shm, llist_shm_node *node)
+{
+  llist_shm_header *h;
+  llist_shm_node *neighbor;
+
+  if (!shm || !node) return;
+
+  h = shm->header;
+
+  if ((neighbor = SHM_PTR(shm, node->previous))) neighbor->next = node->next;
+  else h->head = node->next;
+
+  if ((neighbor = SHM_PTR(shm, node->next))) neighbor->previous = node->previous;
+  else h->tail = node->previous;
+
+  h->count--;
+
+  shm_release(shm, SHM_OFF(shm, node));
+}
+
+  /**
+   *  @fn int llist_shm_import(llist_shm *shm,
+   *                           llist *ll,
+   *                           llist_size_node size_func)
+   *
+   *  @brief Appends a copy of every payload of @p ll to @p shm
+   *
+   *  NOTE:  Payloads are copied as raw bytes, so they must not contain
+   *         pointers.
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  ll - pointer to @a llist to copy
+   *  @param  size_func - pointer to function that returns the payload size of
+   *                      a @a llist_node
+   *
+   *  @return number of nodes copied
+   */
+
+int llist_shm_import(llist_shm *shm, llist *ll, llist_size_node size_func)
+{
+  llist_node *node;
+  int count = 0;
+
+  if (!shm || !ll || !size_func) return 0;
+
+  for (node = llist_head(ll); node; node = llist_next(ll))
+  {
+    if (!llist_shm_add(shm,
+                       llist_position_tail,
+                       NULL,
+                       node->payload,
+                       size_func(node))) break;
+    count++;
+  }
+
+  return count;
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_head(llist_shm *shm)
+   *
+   *  @brief Returns the head of @p shm, if any
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *
+   *  @return pointer to @a llist_shm_node, or NULL on empty list or failure
+   */
+
+llist_shm_node *llist_shm_head(llist_shm *shm)
+{
+  return shm ? SHM_PTR(shm, shm->header->head) : NULL;
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_tail(llist_shm *shm)
+   *
+   *  @brief Returns the tail of @p shm, if any
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *
+   *  @return pointer to @a llist_shm_node, or NULL on empty list or failure
+   */
+
+llist_shm_node *llist_shm_tail(llist_shm *shm)
+{
+  return shm ? SHM_PTR(shm, shm->header->tail) : NULL;
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_previous(llist_shm *shm,
+   *                                         llist_shm_node *node)
+   *
+   *  @brief Returns the node previous to @p node
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  node - pointer to @a llist_shm_node
+   *
+   *  @return pointer to @a llist_shm_node, or NULL at head or on failure
+   */
+
+llist_shm_node *llist_shm_previous(llist_shm *shm, llist_shm_node *node)
+{
+  return (shm && node) ? SHM_PTR(shm, node->previous) : NULL;
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_next(llist_shm *shm, llist_shm_node *node)
+   *
+   *  @brief Returns the node after @p node
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  node - pointer to @a llist_shm_node
+   *
+   *  @return pointer to @a llist_shm_node, or NULL at tail or on failure
+   */
+
+llist_shm_node *llist_shm_next(llist_shm *shm, llist_shm_node *node)
+{
+  return (shm && node) ? SHM_PTR(shm, node->next) : NULL;
+}
+
+  /**
+   *  @fn llist_shm_node *llist_shm_find(llist_shm *shm,
+   *                                     llist_node *needle,
+   *                                     llist_cmp_node cmp_func)
+   *
+   *  @brief Searches for first @p shm node that has the same value as
+   *         @p needle
+   *
+   *  NOTE:  @p cmp_func is the usual list compare function, it is passed an
+   *         @a llist_node whose payload points into the shared node.
+   *
+   *  @param  shm - pointer to @a llist_shm
+   *  @param  needle - @a llist_node that contains payload value to search for
+   *  @param  cmp_func - pointer to function that compares two @a llist_node
+   *
+   *  @return pointer to @a llist_shm_node, or NULL if not found
+   */
+
+llist_shm_node *llist_shm_find(llist_shm *shm,
+                               llist_node *needle,
+                               llist_cmp_node cmp_func)
+{
+  llist_shm_node *node = NULL;
+  llist_node probe;
+
+  if (!shm || !needle || !cmp_func) goto exit;
+
+  memset(&probe, 0, sizeof(llist_node));
+
+  for (node = llist_shm_head(shm); node; node = llist_shm_next(shm, node))
+  {
+    probe.payload = node + 1;
+    if (!cmp_func(&probe, needle)) break;
+  }
+
+exit:
+  return node;
+}
+
+  /**
+   *  @fn void *llist_shm_payload(llist_shm_node *node)
+   *
+   *  @brief Returns the payload bytes of @p node, in this process
+   *
+   *  @param  node - pointer to @a llist_shm_node
+   *
+   *  @return pointer to payload, @p node->size bytes long
+   */
+
+void *llist_shm_payload(llist_shm_node *node)
+{
+  return node ? (void *)(node + 1) : NULL;
+}
@@ -0,0 +1,487 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or (at your
+ *  option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file llist_sort.c
+ * @brief Source code file for external memory sorting of @a llist lists
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "llist_sort.h"
+#include "llist_view_hooks.h"
+
+typedef struct sort_runs sort_runs;
+
+struct sort_runs
+{
+  FILE **files;
+  size_t *lengths;
+  size_t count;
+  size_t size;
+};
+
+typedef struct sort_source sort_source;
+
+struct sort_source
+{
+  llist_node *node;
+  FILE *fp;
+  size_t run;
+  size_t left;
+};
+
+typedef struct sort_output sort_output;
+
+struct sort_output
+{
+  llist *ll;
+  llist_sort_config *config;
+  llist_node *pending;
+  int stopped;
+};
+
+    /*
+     * private functions
+     */
+
+static FILE *sort_tmpfile(const char *tmpdir)
+{
+  char *path = NULL;
+  FILE *fp = NULL;
+  int fd;
+
+  if (!tmpdir) return tmpfile();
+
+  if (!(path = malloc(strlen(tmpdir) + sizeof("/llist-sort-XXXXXX"))))
+    return NULL;
+  sprintf(path, "%s/llist-sort-XXXXXX", tmpdir);
+
+  if ((fd = mkstemp(path)) >= 0)
+  {
+    unlink(path);
+    if (!(fp = fdopen(fd, "w+b"))) close(fd);
+  }
+
+  free(path);
+
+  return fp;
+}
+
+static int sort_runs_push(sort_runs *runs, FILE *fp, size_t length)
+{
+  FILE **files;
+  size_t *lengths;
+  size_t size;
+
+  if (runs->count == runs->size)
+  {
+    size = runs->size ? runs->size * 2 : 16;
+    if (!(files = realloc(runs->files, size * sizeof(FILE *)))) return -1;
+    runs->files = files;
+    if (!(lengths = realloc(runs->lengths, size * sizeof(size_t)))) return -1;
+    runs->lengths = lengths;
+    runs->size = size;
+  }
+
+  runs->files[runs->count] = fp;
+  runs->lengths[runs->count++] = length;
+
+  return 0;
+}
+
+static void sort_runs_close(sort_runs *runs)
+{
+  size_t i;
+
+  for (i = 0; i < runs->count; i++)
+    if (runs->files[i]) fclose(runs->files[i]);
+
+  free(runs->files);
+  free(runs->lengths);
+  memset(runs, 0, sizeof(sort_runs));
+}
+
+static void sort_deliver(sort_output *out, llist_node *node)
+{
+  llist *ll = out->ll;
+
+  if (out->stopped)
+  {
+    llist_release(ll, node);
+    return;
+  }
+
+  if (out->config->sink_node)
+  {
+    if (out->config->sink_node(node, out->config->sink_state))
+      out->stopped = 1;
+    return;
+  }
+
+  node->next = NULL;
+  node->previous = ll->tail;
+  if (ll->tail) ll->tail->next = node;
+  else ll->head = node;
+  ll->tail = node;
+
+#if LLIST_NODE_KEY
+  if (ll->key_node) node->key = ll->key_node(node);
+#endif
+  if (ll->views) llist_view_added(ll, node);
+}
+
+static void sort_emit(sort_output *out, llist_node *node)
+{
+  if (!out->config->unique)
+  {
+    sort_deliver(out, node);
+    return;
+  }
+
+  if (out->pending && !out->ll->cmp_node(out->pending, node))
+  {
+    llist_release(out->ll, node);
+    return;
+  }
+
+  if (out->pending) sort_deliver(out, out->pending);
+  out->pending = node;
+}
+
+static void sort_flush(sort_output *out)
+{
+  if (out->pending) sort_deliver(out, out->pending);
+  out->pending = NULL;
+}
+
+static int sort_rewind(FILE *fp)
+{
+  return (fflush(fp) || fseek(fp, 0L, SEEK_SET)) ? -1 : 0;
+}
+
+static int sort_spill(llist *ll,
+                      llist *run,
+                      llist_sort_config *config,
+                      sort_runs *runs)
+{
+  llist_node *node;
+  FILE *fp;
+  int failed;
+
+  llist_sort(run);
+
+  if (!(fp = sort_tmpfile(config->tmpdir))) return -1;
+  if (sort_runs_push(runs, fp, 0))
+  {
+    fclose(fp);
+    return -1;
+  }
+
+  while ((node = run->head))
+  {
+    llist_unlink(run, node);
+    failed = config->write_node(fp, node);
+    llist_release(ll, node);
+    if (failed) return -1;
+    runs->lengths[runs->count - 1]++;
+  }
+
+  return sort_rewind(fp);
+}
+
+    /*
+     *  binary heap of run heads, ties go to the earlier run so that the
+     *  merge is stable
+     */
+
+static int sort_before(llist_cmp_node cmp, sort_source *a, sort_source *b)
+{
+  int order = cmp(a->node, b->node);
+
+  return order < 0 || (!order && a->run < b->run);
+}
+
+static void sort_sift(llist_cmp_node cmp,
+                      sort_source *heap,
+                      size_t count,
+                      size_t i)
+{
+  sort_source top = heap[i];
+  size_t child;
+
+  while ((child = 2 * i + 1) < count)
+  {
+    if (child + 1 < count && sort_before(cmp, &heap[child + 1], &heap[child]))
+      child++;
+    if (!sort_before(cmp, &heap[child], &top)) break;
+    heap[i] = heap[child];
+    i = child;
+  }
+
+  heap[i] = top;
+}
+
+    /*
+     *  reads the next node of a run, a NULL before the run length is reached
+     *  is a read or deserialize error
+     */
+
+static int sort_next(llist_sort_config *config, sort_source *source)
+{
+  source->node = NULL;
+
+  if (!source->left) return 0;
+  source->left--;
+
+  return (source->node = config->read_node(source->fp)) ? 0 : -1;
+}
+
+static int sort_merge(llist *ll,
+                      llist_sort_config *config,
+                      FILE **files,
+                      size_t *lengths,
+                      size_t count,
+                      FILE *dest,
+                      sort_output *out)
+{
+  sort_source *heap = NULL;
+  llist_node *node;
+  size_t used = 0;
+  size_t i;
+  int failed = 0;
+  int result = -1;
+
+  if (!(heap = malloc(count * sizeof(sort_source)))) goto exit;
+
+  for (i = 0; i < count; i++)
+  {
+    heap[used].fp = files[i];
+    heap[used].run = i;
+    heap[used].left = lengths[i];
+    if (sort_next(config, &heap[used])) goto exit;
+    if (heap[used].node) used++;
+  }
+
+  for (i = used / 2; i-- > 0; )
+    sort_sift(ll->cmp_node, heap, used, i);
+
+  while (used)
+  {
+    node = heap[0].node;
+
+    if (dest)
+    {
+      failed = config->write_node(dest, node);
+      llist_release(ll, node);
+    }
+    else sort_emit(out, node);
+
+      /*
+       *  on failure heap[0] holds no node any more, drop it before cleanup
+       */
+
+    if (failed || sort_next(config, &heap[0]))
+    {
+      heap[0] = heap[--used];
+      goto exit;
+    }
+
+    if (!heap[0].node) heap[0] = heap[--used];
+    if (used) sort_sift(ll->cmp_node, heap, used, 0);
+  }
+
+  result = dest ? sort_rewind(dest) : 0;
+
+exit:
+  if (heap)
+  {
+    for (i = 0; i < used; i++) llist_release(ll, heap[i].node);
+    free(heap);
+  }
+  return result;
+}
+
+    /*
+     * public functions
+     */
+
+  /**
+   *  @fn int llist_sort_external(llist *ll, llist_sort_config *config)
+   *
+   *  @brief Sorts @p ll in ascending order without holding it all in memory
+   *
+   *  Nodes are taken from the head of @p ll until @p config->budget bytes
+   *  (the @a llist_node itself, plus @p config->size_node of each payload)
+   *  have been gathered.  That run is sorted with <i> llist_sort </i>,
+   *  written to a temporary file with @p config->write_node, and its nodes
+   *  freed.  The runs are then merged, at most @p config->fan_in at a time,
+   *  reading nodes back with @p config->read_node, so that only one node
+   *  per run is in memory.  When everything fits within the budget, no file
+   *  is written.
+   *
+   *  The sorted nodes are handed to @p config->sink_node when set, otherwise
+   *  they are linked back into @p ll.  Nodes that compare equal keep their
+   *  original order, and with @p config->unique only the first is kept, the
+   *  others being freed.
+   *
+   *  NOTE:  @p ll compare node function must be set before calling this
+   *         function.  A lazy @p ll is consumed from its generator a
+   *         read-ahead batch at a time, never fully materialized.
+   *
+   *  NOTE:  ll->current will point to ll->head
+   *
+   *  @param  ll - pointer to @a llist
+   *  @param  config - pointer to @a llist_sort_config
+   *
+   *  @return number of runs spilled to temporary files, or -1 on failure.  On
+   *          failure, nodes not yet spilled or delivered remain in @p ll,
+   *          the others are lost.
+   */
+
+int llist_sort_external(llist *ll, llist_sort_config *config)
+{
+  sort_runs runs = { NULL, NULL, 0, 0 };
+  sort_output out;
+  llist *run = NULL;
+  llist_node *node;
+  FILE *fp;
+  size_t fan_in;
+  size_t spilled = 0;
+  size_t bytes = 0;
+  size_t group;
+  size_t length;
+  size_t i, j, k;
+  int failed;
+  int result = -1;
+
+  if (!ll || !ll->cmp_node || !config) goto exit;
+  if (!config->write_node || !config->read_node) goto exit;
+
+  fan_in = config->fan_in > 1 ? config->fan_in : LLIST_SORT_FAN_IN;
+
+  if (!(run = llist_new())) goto exit;
+  llist_set_cmp(run, ll->cmp_node);
+
+  while ((node = llist_head(ll)))
+  {
+    llist_unlink(ll, node);
+    llist_add(run, llist_position_tail, NULL, node);
+
+    bytes += sizeof(llist_node);
+    if (config->size_node) bytes += config->size_node(node);
+    if (!config->budget || bytes < config->budget) continue;
+
+    if (sort_spill(ll, run, config, &runs)) goto exit;
+    bytes = 0;
+  }
+
+  memset(&out, 0, sizeof(sort_output));
+  out.ll = ll;
+  out.config = config;
+
+    /*
+     *  a sink frees what it is given, so it may not be handed nodes that
+     *  live in blocks owned by ll
+     */
+
+  if (!runs.count && !(config->sink_node && ll->blocks))
+  {
+    llist_sort(run);
+    while ((node = run->head))
+    {
+      llist_unlink(run, node);
+      sort_emit(&out, node);
+    }
+    sort_flush(&out);
+    result = 0;
+    goto exit;
+  }
+
+  if (run->head && sort_spill(ll, run, config, &runs)) goto exit;
+  spilled = runs.count;
+
+  while (runs.count > fan_in)
+  {
+    for (i = j = 0; i < runs.count; i += group, j++)
+    {
+      group = runs.count - i < fan_in ? runs.count - i : fan_in;
+
+      if (!(fp = sort_tmpfile(config->tmpdir))) goto exit;
+      failed = sort_merge(ll,
+                          config,
+                          runs.files + i,
+                          runs.lengths + i,
+                          group,
+                          fp,
+                          NULL);
+
+      for (length = 0, k = i; k < i + group; k++)
+      {
+        length += runs.lengths[k];
+        fclose(runs.files[k]);
+        runs.files[k] = NULL;
+      }
+
+      if (failed)
+      {
+        fclose(fp);
+        goto exit;
+      }
+
+      runs.files[j] = fp;
+      runs.lengths[j] = length;
+    }
+    runs.count = j;
+  }
+
+  if (sort_merge(ll,
+                 config,
+                 runs.files,
+                 runs.lengths,
+                 runs.count,
+                 NULL,
+                 &out))
+    goto exit;
+  sort_flush(&out);
+
+  result = (int)spilled;
+
+exit:
+  if (run)
+  {
+    while ((node = run->tail))
+    {
+      llist_unlink(run, node);
+      node->next = ll->head;
+      if (ll->head) ll->head->previous = node;
+      else ll->tail = node;
+      ll->head = node;
+      if (ll->views) llist_view_added(ll, node);
+    }
+    llist_free(run);
+  }
+  sort_runs_close(&runs);
+  if (ll) ll->current = ll->head;
+  return result;
+}
@@ -0,0 +1,586 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or (at your
+ *  option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file llist_view.c
+ * @brief Source code file for filtered and sorted views of an @a llist, kept
+ *        current as the list changes
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "llist_view_hooks.h"
+
+#define LLIST_VIEW_BUCKETS 64   /**<  initial number of hash table buckets  */
+
+typedef struct llist_view_link llist_view_link;
+
+struct llist_view_link
+{
+  llist_view_entry *next;       /**<  next entry on this level, NULL at end  */
+  llist_view_entry *previous;   /**<  previous entry on this level, NULL at head  */
+};
+
+struct llist_view_entry
+{
+  llist_node node;              /**<  shadow node, linked in view->ll  */
+  llist_node *base;             /**<  node of the base list  */
+  llist_view_entry *chain;      /**<  next entry in hash bucket  */
+  unsigned long seq;            /**<  insertion order, breaks ties  */
+  int levels;                   /**<  skip list height  */
+  llist_view_link link[];       /**<  skip list links, sorted views only  */
+};
+
+    /*
+     * private functions
+     */
+
+static size_t view_hash(llist_view *view, llist_node *node)
+{
+  return (size_t)(((uintptr_t)node >> 4) * 0x9e3779b97f4a7c15ULL) &
+         (view->nbuckets - 1);
+}
+
+static llist_view_entry **view_slot(llist_view *view, llist_node *node)
+{
+  llist_view_entry **slot = &view->buckets[view_hash(view, node)];
+
+  while (*slot && (*slot)->base != node) slot = &(*slot)->chain;
+
+  return slot;
+}
+
+static void view_grow(llist_view *view)
+{
+  llist_view_entry **buckets, **old = view->buckets;
+  llist_view_entry *entry, *chain;
+  size_t nbuckets = view->nbuckets;
+  size_t i;
+
+  if (!(buckets = calloc(nbuckets * 2, sizeof(llist_view_entry *)))) return;
+
+  view->buckets = buckets;
+  view->nbuckets = nbuckets * 2;
+
+  for (i = 0; i < nbuckets; i++)
+    for (entry = old[i]; entry; entry = chain)
+    {
+      chain = entry->chain;
+      entry->chain = view->buckets[view_hash(view, entry->base)];
+      view->buckets[view_hash(view, entry->base)] = entry;
+    }
+
+  free(old);
+}
+
+static int view_before(llist_view *view,
+                       llist_view_entry *a,
+                       llist_view_entry *b)
+{
+  int order = view->cmp_node(&a->node, &b->node);
+
+  return order < 0 || (!order && a->seq < b->seq);
+}
+
+    /*
+     *  update[i] is the entry after which @p entry goes on level i, NULL for
+     *  the head of the level
+     */
+
+static void view_search(llist_view *view,
+                        llist_view_entry *entry,
+                        llist_view_entry **update)
+{
+  llist_view_entry *at = NULL;
+  llist_view_entry *next;
+  int i;
+
+  for (i = view->levels - 1; i >= 0; i--)
+  {
+    next = at ? at->link[i].next : view->skip[i];
+    while (next && view_before(view, next, entry))
+    {
+      at = next;
+      next = at->link[i].next;
+    }
+    update[i] = at;
+  }
+}
+
+static int view_level(llist_view *view)
+{
+  unsigned int r;
+  int levels = 1;
+
+  r = view->random;
+  r ^= r << 13;
+  r ^= r >> 17;
+  r ^= r << 5;
+  view->random = r;
+
+  while ((r & 3) == 3 && levels < LLIST_VIEW_LEVELS)
+  {
+    levels++;
+    r >>= 2;
+  }
+
+  return levels;
+}
+
+static llist_view_entry *view_entry_new(llist_view *view, llist_node *node)
+{
+  llist_view_entry *entry;
+  int levels = view->cmp_node ? view_level(view) : 0;
+
+  entry = malloc(sizeof(llist_view_entry) + levels * sizeof(llist_view_link));
+  if (!entry) return NULL;
+
+  memset(entry, 0, sizeof(llist_view_entry));
+  entry->node.payload = node->payload;
+  entry->base = node;
+  entry->seq = ++view->seq;
+  entry->levels = levels;
+
+  return entry;
+}
+
+static void view_link_sorted(llist_view *view, llist_view_entry *entry)
+{
+  llist_view_entry *update[LLIST_VIEW_LEVELS];
+  llist_view_entry *previous, *next;
+  int i;
+
+  while (view->levels < entry->levels) view->skip[view->levels++] = NULL;
+
+  view_search(view, entry, update);
+
+  for (i = 0; i < entry->levels; i++)
+  {
+    previous = update[i];
+    next = previous ? previous->link[i].next : view->skip[i];
+    entry->link[i].previous = previous;
+    entry->link[i].next = next;
+    if (previous) previous->link[i].next = entry;
+    else view->skip[i] = entry;
+    if (next) next->link[i].previous = entry;
+  }
+
+  next = entry->link[0].next;
+  if (next) llist_add(view->ll, llist_position_before, &next->node, &entry->node);
+  else llist_add(view->ll, llist_position_tail, NULL, &entry->node);
+}
+
+    /*
+     *  unlinking uses only the links of @p entry, never the compare function,
+     *  so it still works after the payload changed
+     */
+
+static void view_unlink_sorted(llist_view *view, llist_view_entry *entry)
+{
+  llist_view_link *link;
+  int i;
+
+  for (i = 0; i < entry->levels; i++)
+  {
+    link = &entry->link[i];
+    if (link->previous) link->previous->link[i].next = link->next;
+    else view->skip[i] = link->next;
+    if (link->next) link->next->link[i].previous = link->previous;
+  }
+
+  while (view->levels && !view->skip[view->levels - 1]) view->levels--;
+}
+
+    /*
+     *  base order: find the nearest neighbor of @p node that is in the view,
+     *  looking both ways at once, so the cost is the smaller gap, O(n) in
+     *  the worst case; base nodes carry no order labels to search on
+     */
+
+static void view_link_ordered(llist_view *view, llist_view_entry *entry)
+{
+  llist_node *back = entry->base->previous;
+  llist_node *ahead = entry->base->next;
+  llist_view_entry *found;
+
+  for (;;)
+  {
+    if (!ahead)
+    {
+      llist_add(view->ll, llist_position_tail, NULL, &entry->node);
+      return;
+    }
+    if ((found = *view_slot(view, ahead)))
+    {
+      llist_add(view->ll, llist_position_before, &found->node, &entry->node);
+      return;
+    }
+    if (!back)
+    {
+      llist_add(view->ll, llist_position_head, NULL, &entry->node);
+      return;
+    }
+    if ((found = *view_slot(view, back)))
+    {
+      llist_add(view->ll, llist_position_after, &found->node, &entry->node);
+      return;
+    }
+
+    back = back->previous;
+    ahead = ahead->next;
+  }
+}
+
+static void view_insert(llist_view *view, llist_node *node, int at_tail)
+{
+  llist_view_entry *entry;
+  llist_view_entry **slot;
+
+  if (view->filter_node && !view->filter_node(node)) return;
+
+  if (*(slot = view_slot(view, node))) return;
+
+  if (!(entry = view_entry_new(view, node))) return;
+
+  *slot = entry;
+  view->count++;
+
+  if (view->cmp_node) view_link_sorted(view, entry);
+  else if (at_tail) llist_add(view->ll, llist_position_tail, NULL, &entry->node);
+  else view_link_ordered(view, entry);
+
+  if (view->count > view->nbuckets) view_grow(view);
+}
+
+static void view_erase(llist_view *view, llist_node *node)
+{
+  llist_view_entry **slot;
+  llist_view_entry *entry;
+
+  if (!(entry = *(slot = view_slot(view, node)))) return;
+
+  *slot = entry->chain;
+  view->count--;
+
+  if (view->cmp_node) view_unlink_sorted(view, entry);
+
+  llist_unlink(view->ll, &entry->node);
+  free(entry);
+}
+
+static void view_clear(llist_view *view)
+{
+  llist_view_entry *entry;
+  size_t i;
+
+  for (i = 0; i < view->nbuckets; i++)
+    while ((entry = view->buckets[i]))
+    {
+      view->buckets[i] = entry->chain;
+      llist_unlink(view->ll, &entry->node);
+      free(entry);
+    }
+
+  memset(view->skip, 0, sizeof(view->skip));
+  view->levels = 0;
+  view->count = 0;
+}
+
+static void view_fill(llist_view *view)
+{
+  llist_node *node;
+
+  for (node = view->base->head; node; node = node->next)
+    view_insert(view, node, 1);
+}
+
+    /*
+     * public functions
+     */
+
+  /**
+   *  @fn llist_view *llist_view_new(llist *base,
+   *                                 llist_filter_node filter_func,
+   *                                 llist_cmp_node cmp_func)
+   *
+   *  @brief Creates a view of @p base, holding the nodes accepted by
+   *         @p filter_func, ordered by @p cmp_func
+   *
+   *  The view is filled from the nodes already in @p base, then kept current
+   *  by <i> llist_add </i>, <i> llist_remove </i>, <i> llist_unlink </i> and
+   *  the other functions that change @p base.  Each change costs O(log n)
+   *  per sorted view.  An unsorted view keeps the order of @p base, and a
+   *  change costs the distance to the nearest node also in the view: O(1)
+   *  for nodes added at the head or tail of @p base, but up to O(n) for a
+   *  node added in the middle of @p base when @p filter_func accepts few
+   *  nodes.  Pass a @p cmp_func reflecting the @p base order if that
+   *  matters.
+   *
+   *  NOTE:  Nodes of a lazy @p base enter the view as they are generated.
+   *
+   *  NOTE:  If the payload of a node changes in a way that affects
+   *         @p filter_func or @p cmp_func, <i> llist_view_refresh </i> MUST
+   *         be called on it.
+   *
+   *  @param  base - pointer to @a llist to view
+   *  @param  filter_func - function selecting nodes, NULL for all nodes
+   *  @param  cmp_func - function ordering nodes, NULL for the @p base order
+   *
+   *  @return pointer to new @a llist_view, or NULL on failure
+   */
+
+llist_view *llist_view_new(llist *base,
+                           llist_filter_node filter_func,
+                           llist_cmp_node cmp_func)
+{
+  llist_view *view = NULL;
+
+  if (!base) goto exit;
+
+  if (!(view = malloc(sizeof(llist_view)))) goto exit;
+  memset(view, 0, sizeof(llist_view));
+
+  view->nbuckets = LLIST_VIEW_BUCKETS;
+  view->ll = llist_new();
+  view->buckets = calloc(view->nbuckets, sizeof(llist_view_entry *));
+  if (!view->ll || !view->buckets)
+  {
+    llist_free(view->ll);
+    free(view->buckets);
+    free(view);
+    view = NULL;
+    goto exit;
+  }
+
+  llist_set_cmp(view->ll, cmp_func);
+
+  view->base = base;
+  view->filter_node = filter_func;
+  view->cmp_node = cmp_func;
+  view->random = 0x2545f491;
+
+  view_fill(view);
+
+  view->next = base->views;
+  base->views = view;
+
+exit:
+  return view;
+}
+
+  /**
+   *  @fn void llist_view_free(llist_view *view)
+   *
+   *  @brief Detaches @p view from its base list and frees it
+   *
+   *  NOTE:  The payloads are owned by the base list, and are not freed
+   *
+   *  @param  view - pointer to @a llist_view
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_free(llist_view *view)
+{
+  llist_view **link;
+
+  if (!view) return;
+
+  if (view->base)
+  {
+    for (link = &view->base->views; *link != view; link = &(*link)->next);
+    *link = view->next;
+  }
+
+  view_clear(view);
+
+  llist_free(view->ll);
+  free(view->buckets);
+  free(view);
+}
+
+  /**
+   *  @fn void llist_view_refresh(llist *base, llist_node *node)
+   *
+   *  @brief Re-evaluates @p node, a member of @p base, in every view of
+   *         @p base, after its payload changed
+   *
+   *  @param  base - pointer to @a llist
+   *  @param  node - pointer to @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_refresh(llist *base, llist_node *node)
+{
+  llist_view *view;
+
+  if (!base || !node) return;
+
+  for (view = base->views; view; view = view->next)
+  {
+    view_erase(view, node);
+    view_insert(view, node, 0);
+  }
+}
+
+  /**
+   *  @fn llist_node *llist_view_base(llist_node *node)
+   *
+   *  @brief Returns the base list node behind @p node, a node of a view
+   *
+   *  @param  node - pointer to @a llist_node in view->ll
+   *
+   *  @return pointer to @a llist_node, or NULL on failure
+   */
+
+llist_node *llist_view_base(llist_node *node)
+{
+  return node ? ((llist_view_entry *)node)->base : NULL;
+}
+
+  /**
+   *  @fn void llist_view_added(llist *base, llist_node *node)
+   *
+   *  @brief Enters @p node, just linked into @p base, in the views of @p base
+   *
+   *  @param  base - pointer to @a llist
+   *  @param  node - pointer to @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_added(llist *base, llist_node *node)
+{
+  llist_view *view;
+
+  for (view = base->views; view; view = view->next)
+    view_insert(view, node, !node->next);
+}
+
+  /**
+   *  @fn void llist_view_removed(llist *base, llist_node *node)
+   *
+   *  @brief Drops @p node, about to leave @p base, from the views of @p base
+   *
+   *  @param  base - pointer to @a llist
+   *  @param  node - pointer to @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_removed(llist *base, llist_node *node)
+{
+  llist_view *view;
+
+  for (view = base->views; view; view = view->next)
+    view_erase(view, node);
+}
+
+  /**
+   *  @fn void llist_view_moved(llist *base, llist_node *from, llist_node *to)
+   *
+   *  @brief Follows a node of @p base relocated from @p from to @p to
+   *
+   *  @param  base - pointer to @a llist
+   *  @param  from - old address of the @a llist_node
+   *  @param  to - new address of the @a llist_node
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_moved(llist *base, llist_node *from, llist_node *to)
+{
+  llist_view *view;
+  llist_view_entry **slot;
+  llist_view_entry *entry;
+
+  for (view = base->views; view; view = view->next)
+  {
+    if (!(entry = *(slot = view_slot(view, from)))) continue;
+
+    *slot = entry->chain;
+    entry->base = to;
+    slot = &view->buckets[view_hash(view, to)];
+    entry->chain = *slot;
+    *slot = entry;
+  }
+}
+
+  /**
+   *  @fn void llist_view_reordered(llist *base)
+   *
+   *  @brief Rebuilds the views of @p base that follow its order, after
+   *         @p base was reordered
+   *
+   *  @param  base - pointer to @a llist
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_reordered(llist *base)
+{
+  llist_view *view;
+
+  for (view = base->views; view; view = view->next)
+  {
+    if (view->cmp_node) continue;
+    view_clear(view);
+    view_fill(view);
+  }
+}
+
+  /**
+   *  @fn void llist_view_detach(llist *base)
+   *
+   *  @brief Empties the views of @p base and detaches them, as @p base is
+   *         about to be freed
+   *
+   *  NOTE:  The views must still be freed with <i> llist_view_free </i>
+   *
+   *  @param  base - pointer to @a llist
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_view_detach(llist *base)
+{
+  llist_view *view, *next;
+
+  for (view = base->views; view; view = next)
+  {
+    next = view->next;
+    view_clear(view);
+    view->base = NULL;
+    view->next = NULL;
+  }
+
+  base->views = NULL;
+}
@@ -0,0 +1,35 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ *  @file llist_view_hooks.h
+ *  @brief Private header file for the @a llist_view hooks, called by the
+ *         @a llist functions on the base list.  Not installed.
+ */
+
+#ifndef LLIST_VIEW_HOOKS_H
+#define LLIST_VIEW_HOOKS_H
+
+#include "llist_view.h"
+
+void llist_view_added(llist *base, llist_node *node);
+void llist_view_removed(llist *base, llist_node *node);
+void llist_view_moved(llist *base, llist_node *from, llist_node *to);
+void llist_view_reordered(llist *base);
+void llist_view_detach(llist *base);
+
+#endif //LLIST_VIEW_HOOKS_H
@@ -0,0 +1,376 @@
+/*
+ *  Copyright 2026 Patrick T. Head
+ *
+ *  This program is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or (at your
+ *  option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file llist_wheel.c
+ * @brief Source code file for hierarchical timing wheel built on @a llist
+ *        buckets
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "llist_wheel.h"
+
+#define WHEEL_MASK (LLIST_WHEEL_SLOTS - 1)
+#define WHEEL_SPAN(level) (1UL << ((level) * LLIST_WHEEL_BITS))
+
+    /*
+     * private functions
+     */
+
+static int wheel_owns(llist_wheel *w, llist *bucket)
+{
+  return bucket >= &w->buckets[0][0] &&
+         bucket < &w->buckets[0][0] + LLIST_WHEEL_LEVELS * LLIST_WHEEL_SLOTS;
+}
+
+static void wheel_place(llist_wheel *w, llist_timer *timer)
+{
+  unsigned long expires = timer->expires;
+  unsigned long delta = expires - w->now;
+  int level;
+
+  if ((long)delta < 0)
+  {
+    level = 0;
+    expires = w->now;
+  }
+  else
+  {
+    for (level = 0; level < LLIST_WHEEL_LEVELS - 1; level++)
+      if (delta < WHEEL_SPAN(level + 1)) break;
+
+    if (delta >= WHEEL_SPAN(LLIST_WHEEL_LEVELS))
+      expires = w->now + WHEEL_SPAN(LLIST_WHEEL_LEVELS) - 1;
+  }
+
+  timer->bucket =
+    &w->buckets[level][(expires >> (level * LLIST_WHEEL_BITS)) & WHEEL_MASK];
+
+  llist_add(timer->bucket, llist_position_tail, NULL, &timer->node);
+}
+
+static void wheel_splice(llist *to, llist *from)
+{
+  if (!from->head) return;
+
+  if (to->tail)
+  {
+    to->tail->next = from->head;
+    from->head->previous = to->tail;
+  }
+  else to->head = from->head;
+
+  to->tail = from->tail;
+  from->head = from->tail = from->current = NULL;
+}
+
+static int wheel_cascade(llist_wheel *w, int level)
+{
+  llist bucket;
+  llist_node *node, *next;
+  int index;
+
+  index = (w->now >> (level * LLIST_WHEEL_BITS)) & WHEEL_MASK;
+
+  memset(&bucket, 0, sizeof(llist));
+  wheel_splice(&bucket, &w->buckets[level][index]);
+
+  for (node = bucket.head; node; node = next)
+  {
+    next = node->next;
+    wheel_place(w, (llist_timer *)node);
+  }
+
+  return index;
+}
+
+static void wheel_dispose(llist_wheel *w, llist_node *node)
+{
+  if (w->free_node) w->free_node(node);
+  else llist_node_free(node);
+}
+
+    /*
+     * public functions
+     */
+
+  /**
+   *  @fn llist_wheel *llist_wheel_new(void)
+   *
+   *  @brief Create a hierarchical timing wheel
+   *
+   *  @par Parameters
+   *       None.
+   *
+   *  @return pointer to new @a llist_wheel, or NULL on failure
+   */
+
+llist_wheel *llist_wheel_new(void)
+{
+  llist_wheel *w = NULL;
+  int level, slot;
+
+  if (!(w = malloc(sizeof(llist_wheel)))) goto exit;
+
+  memset(w, 0, sizeof(llist_wheel));
+
+  for (level = 0; level < LLIST_WHEEL_LEVELS; level++)
+    for (slot = 0; slot < LLIST_WHEEL_SLOTS; slot++)
+      w->buckets[level][slot].pinned = 1;
+
+exit:
+  return w;
+}
+
+  /**
+   *  @fn void llist_wheel_free(llist_wheel *w)
+   *
+   *  @brief Frees all memory allocated to @p w, including pending timers
+   *
+   *  NOTE:  Pending timers are freed with @p w->free_node, they do not expire
+   *
+   *  @param w - pointer to @a llist_wheel struct
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_wheel_free(llist_wheel *w)
+{
+  llist_node *node, *next;
+  int level, slot;
+
+  if (!w) goto exit;
+
+  for (level = 0; level < LLIST_WHEEL_LEVELS; level++)
+  {
+    for (slot = 0; slot < LLIST_WHEEL_SLOTS; slot++)
+    {
+      for (node = w->buckets[level][slot].head; node; node = next)
+      {
+        next = node->next;
+        wheel_dispose(w, node);
+      }
+    }
+  }
+
+  free(w);
+
+exit:
+}
+
+  /**
+   *  @fn void llist_wheel_set_free(llist_wheel *w, llist_free_node free_func)
+   *
+   *  @brief Sets timer free function in @p w
+   *
+   *  NOTE:  @p free_func receives an @a llist_timer cast to @a llist_node, and
+   *         should release its payload and the timer itself, with
+   *         <i> llist_node_free </i> or <i> free </i>.
+   *
+   *  @param  w - pointer to @a llist_wheel
+   *  @param  free_func - pointer to function that frees an @a llist_timer
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_wheel_set_free(llist_wheel *w, llist_free_node free_func)
+{
+  if (w) w->free_node = free_func;
+}
+
+  /**
+   *  @fn void llist_wheel_set_expire(llist_wheel *w,
+   *                                  llist_wheel_expire expire_func)
+   *
+   *  @brief Sets batch expiry function in @p w
+   *
+   *  @param  w - pointer to @a llist_wheel
+   *  @param  expire_func - pointer to function that receives expired timers
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_wheel_set_expire(llist_wheel *w, llist_wheel_expire expire_func)
+{
+  if (w) w->expire = expire_func;
+}
+
+  /**
+   *  @fn llist_timer *llist_wheel_schedule(llist_wheel *w,
+   *                                        void *payload,
+   *                                        unsigned long ticks)
+   *
+   *  @brief Schedules a timer carrying @p payload, in constant time
+   *
+   *  NOTE:  The timer expires during the <i> llist_wheel_advance </i> call
+   *         that processes tick @p w->now + @p ticks.
+   *
+   *  @param  w - pointer to @a llist_wheel
+   *  @param  payload - points to user supplied payload for the timer
+   *  @param  ticks - number of ticks until expiry
+   *
+   *  @return pointer to new @a llist_timer, or NULL on failure
+   */
+
+llist_timer *llist_wheel_schedule(llist_wheel *w,
+                                  void *payload,
+                                  unsigned long ticks)
+{
+  llist_timer *timer = NULL;
+
+  if (!w) goto exit;
+
+  if (!(timer = malloc(sizeof(llist_timer)))) goto exit;
+  memset(timer, 0, sizeof(llist_timer));
+
+  timer->node.payload = payload;
+  timer->expires = w->now + ticks;
+
+  wheel_place(w, timer);
+  w->pending++;
+
+exit:
+  return timer;
+}
+
+  /**
+   *  @fn void llist_wheel_reschedule(llist_wheel *w,
+   *                                  llist_timer *timer,
+   *                                  unsigned long ticks)
+   *
+   *  @brief Moves @p timer to expire @p ticks from now, in constant time
+   *
+   *  NOTE:  @p timer may be pending, or in the batch passed to the expiry
+   *         function, which keeps it from being freed.
+   *
+   *  @param  w - pointer to @a llist_wheel
+   *  @param  timer - pointer to @a llist_timer
+   *  @param  ticks - number of ticks until expiry
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_wheel_reschedule(llist_wheel *w,
+                            llist_timer *timer,
+                            unsigned long ticks)
+{
+  if (!w || !timer) goto exit;
+
+  if (timer->bucket)
+  {
+    if (wheel_owns(w, timer->bucket)) w->pending--;
+    llist_unlink(timer->bucket, &timer->node);
+  }
+
+  timer->expires = w->now + ticks;
+
+  wheel_place(w, timer);
+  w->pending++;
+
+exit:
+}
+
+  /**
+   *  @fn void llist_wheel_cancel(llist_wheel *w, llist_timer *timer)
+   *
+   *  @brief Cancels and frees @p timer, in constant time
+   *
+   *  @param  w - pointer to @a llist_wheel
+   *  @param  timer - pointer to @a llist_timer
+   *
+   *  @par Returns
+   *       Nothing.
+   */
+
+void llist_wheel_cancel(llist_wheel *w, llist_timer *timer)
+{
+  if (!w || !timer) goto exit;
+
+  if (timer->bucket)
+  {
+    if (wheel_owns(w, timer->bucket)) w->pending--;
+    llist_unlink(timer->bucket, &timer->node);
+  }
+
+  wheel_dispose(w, &timer->node);
+
+exit:
+}
+
+  /**
+   *  @fn unsigned long llist_wheel_advance(llist_wheel *w, unsigned long ticks)
+   *
+   *  @brief Processes the next @p ticks ticks of @p w
+   *
+   *  Timers expiring in those ticks are collected, in expiry order, into a
+   *  single batch that is passed to @p w->expire, when set.  Timers left in
+   *  the batch afterwards are freed with @p w->free_node.
+   *
+   *  @param  w - pointer to @a llist_wheel
+   *  @param  ticks - number of ticks to process
+   *
+   *  @return number of expired timers
+   */
+
+unsigned long llist_wheel_advance(llist_wheel *w, unsigned long ticks)
+{
+  llist expired;
+  llist_node *node, *next;
+  unsigned long count = 0;
+  int level, index;
+
+  if (!w) goto exit;
+
+  memset(&expired, 0, sizeof(llist));
+  expired.pinned = 1;
+
+  while (ticks--)
+  {
+    index = w->now & WHEEL_MASK;
+
+    for (level = 1; !index && level < LLIST_WHEEL_LEVELS; level++)
+      index = wheel_cascade(w, level);
+
+    wheel_splice(&expired, &w->buckets[0][w->now & WHEEL_MASK]);
+    w->now++;
+  }
+
+  for (node = expired.head; node; node = node->next)
+  {
+    ((llist_timer *)node)->bucket = &expired;
+    count++;
+  }
+
+  w->pending -= count;
+
+  if (count && w->expire) w->expire(&expired);
+
+  for (node = expired.head; node; node = next)
+  {
+    next = node->next;
+    wheel_dispose(w, node);
+  }
+
+exit:
+  return count;
+}
@@ -0,0 +1,267 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "llist_lru.h"
+
+typedef struct item item;
+
+struct item
+{
+  int id;
+  char *name;
+};
+
+llist_node *new_node(int id);
+llist_node *dup_node(llist_node *node);
+void free_node(llist_node *node);
+void evict_node(llist_node *node);
+int cmp_node(llist_node *a, llist_node *b);
+unsigned long hash_node(llist_node *node);
+size_t size_node(llist_node *node);
+void print_lru(llist_lru *lru);
+
+int _evicted = 0;
+
+int main()
+{
+  llist_lru *lru = NULL;
+  llist_node *node = NULL;
+  item it = { 0, NULL };
+  llist_node needle = { NULL, NULL, &it };
+  int errors = 0;
+  int i;
+
+  printf("llist_lru_new(4, 0)\n");
+  lru = llist_lru_new(4, 0);
+  printf("lru = %p\n", lru);
+
+  llist_set_dup(lru->ll, dup_node);
+  llist_set_free(lru->ll, free_node);
+  llist_set_cmp(lru->ll, cmp_node);
+
+  printf("llist_lru_set_hash(%p, %p)\n", lru, hash_node);
+  llist_lru_set_hash(lru, hash_node);
+
+  printf("llist_lru_set_evict(%p, %p)\n", lru, evict_node);
+  llist_lru_set_evict(lru, evict_node);
+
+  for (i = 1; i <= 4; i++)
+  {
+    node = new_node(i);
+    printf("llist_lru_put(%p, %p)\n", lru, node);
+    llist_lru_put(lru, node);
+    free_node(node);
+  }
+
+  print_lru(lru);
+
+  it.id = 1;
+  printf("llist_lru_get(%p, &needle) id=%d\n", lru, it.id);
+  node = llist_lru_get(lru, &needle);
+  printf("node=%p\n", node);
+  if (!node || lru->ll->head != node) errors++;
+
+  node = new_node(5);
+  printf("llist_lru_put(%p, %p)\n", lru, node);
+  llist_lru_put(lru, node);
+  free_node(node);
+
+  print_lru(lru);
+
+  it.id = 2;
+  printf("llist_lru_get(%p, &needle) id=%d\n", lru, it.id);
+  node = llist_lru_get(lru, &needle);
+  printf("node=%p\n", node);
+  if (node || _evicted != 1) errors++;
+
+  node = lru->ll->tail;
+  printf("llist_lru_touch(%p, %p)\n", lru, node);
+  llist_lru_touch(lru, node);
+  if (lru->ll->head != node) errors++;
+
+  node = lru->ll->tail;
+  printf("llist_lru_remove(%p, %p)\n", lru, node);
+  llist_lru_remove(lru, node);
+  if (lru->count != 3) errors++;
+
+  print_lru(lru);
+
+  printf("llist_lru_free(%p)\n", lru);
+  llist_lru_free(lru);
+
+  printf("llist_lru_new(0, %zu)\n", 3 * sizeof(item));
+  lru = llist_lru_new(0, 3 * sizeof(item));
+  llist_set_dup(lru->ll, dup_node);
+  llist_set_free(lru->ll, free_node);
+  llist_set_cmp(lru->ll, cmp_node);
+  llist_lru_set_hash(lru, hash_node);
+
+  printf("llist_lru_set_size(%p, %p)\n", lru, size_node);
+  llist_lru_set_size(lru, size_node);
+
+  for (i = 10; i < 100; i++)
+  {
+    node = new_node(i);
+    llist_lru_put(lru, node);
+    free_node(node);
+  }
+
+  print_lru(lru);
+  if (lru->count != 3 || lru->bytes != 3 * sizeof(item)) errors++;
+
+  printf("llist_lru_free(%p)\n", lru);
+  llist_lru_free(lru);
+
+  printf("llist_lru_new(10, 0)\n");
+  lru = llist_lru_new(10, 0);
+  llist_set_dup(lru->ll, dup_node);
+  llist_set_free(lru->ll, free_node);
+  llist_set_cmp(lru->ll, cmp_node);
+  llist_lru_set_hash(lru, hash_node);
+  llist_lru_set_evict(lru, evict_node);
+
+  for (i = 1; i <= 10; i++)
+  {
+    node = new_node(i);
+    llist_lru_put(lru, node);
+    free_node(node);
+  }
+
+  printf("llist_compact(%p, 0)\n", lru->ll);
+  if (!llist_compact(lru->ll, 0)) errors++;
+
+  it.id = 5;
+  node = llist_lru_get(lru, &needle);
+  printf("llist_lru_get(%p, &needle) id=%d, node=%p\n", lru, it.id, node);
+  if (!node || lru->ll->head != node) errors++;
+
+  _evicted = 0;
+  node = new_node(11);
+  printf("llist_lru_put(%p, %p)\n", lru, node);
+  llist_lru_put(lru, node);
+  free_node(node);
+  if (lru->count != 10 || _evicted != 1) errors++;
+
+  print_lru(lru);
+
+  printf("llist_lru_free(%p)\n", lru);
+  llist_lru_free(lru);
+
+  printf("errors=%d\n", errors);
+
+  return errors ? 1 : 0;
+}
+
+llist_node *new_node(int id)
+{
+  llist_node *node = NULL;
+  item *it = NULL;
+  char name[50];
+
+  if (!(it = malloc(sizeof(item)))) goto exit;
+
+  it->id = id;
+  sprintf(name, "name%d", id);
+  it->name = strdup(name);
+
+  node = llist_node_new((void *)it);
+
+exit:
+  return node;
+}
+
+llist_node *dup_node(llist_node *node)
+{
+  llist_node *new_node = NULL;
+  item *node_it = NULL;
+  item *it = NULL;
+
+  if (!node) goto exit;
+
+  if (node->payload)
+  {
+    it = malloc(sizeof(item));
+    node_it = (item *)node->payload;
+    memcpy(it, node_it, sizeof(item));
+    if (node_it->name) it->name = strdup(node_it->name);
+  }
+
+  new_node = llist_node_new((void *)it);
+
+exit:
+  return new_node;
+}
+
+void free_node(llist_node *node)
+{
+  item *it;
+
+  if (!node) return;
+
+  if (node->payload)
+  {
+    it = (item *)node->payload;
+    if (it->name) free(it->name);
+    free(it);
+  }
+
+  llist_node_free(node);
+}
+
+void evict_node(llist_node *node)
+{
+  printf("evict_node(%p) id=%d\n", node, ((item *)node->payload)->id);
+  _evicted++;
+  free_node(node);
+}
+
+int cmp_node(llist_node *a, llist_node *b)
+{
+  item *a_it, *b_it;
+
+  if (!a || !b) return 0;
+
+  a_it = (item *)a->payload;
+  b_it = (item *)b->payload;
+
+  if (!a_it || !b_it) return 0;
+
+  if (a_it->id < b_it->id) return -1;
+  if (a_it->id > b_it->id) return 1;
+  return 0;
+}
+
+unsigned long hash_node(llist_node *node)
+{
+  return (unsigned long)((item *)node->payload)->id * 2654435761UL;
+}
+
+size_t size_node(llist_node *node)
+{
+  return sizeof(item);
+}
+
+void print_lru(llist_lru *lru)
+{
+  llist_node *node = NULL;
+  item *it;
+
+  if (!lru) return;
+
+  printf("LLIST_LRU:\n");
+  printf("  count=%zu\n", lru->count);
+  printf("  bytes=%zu\n", lru->bytes);
+  printf("  hits=%lu\n", lru->hits);
+  printf("  misses=%lu\n", lru->misses);
+  printf("  evictions=%lu\n", lru->evictions);
+  printf("  NODES:\n");
+
+  for (node = lru->ll->head; node; node = node->next)
+  {
+    it = (item *)node->payload;
+    printf("    NODE (%p)\n", node);
+    printf("      id=%d\n", it->id);
+    printf("      name=%s\n", it->name);
+  }
+}
@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "llist_queue.h"
+
+#define MESSAGES 100000
+
+void *producer(void *arg);
+
+int main()
+{
+  llist_queue *q = NULL;
+  llist batch;
+  llist_node *node = NULL;
+  pthread_t p;
+  uint64_t value;
+  intptr_t expect;
+  size_t count;
+  int efd;
+  int errors = 0;
+  int i;
+
+  memset(&batch, 0, sizeof(llist));
+
+  printf("llist_queue_new(4)\n");
+  q = llist_queue_new(4);
+  printf("q = %p\n", q);
+
+  efd = llist_queue_eventfd(q);
+  printf("llist_queue_eventfd(%p) = %d\n", q, efd);
+
+  for (i = 1; i <= 4; i++)
+  {
+    printf("llist_queue_push(%p, node, 0) = ", q);
+    printf("%d\n", llist_queue_push(q, llist_node_new((void *)(intptr_t)i), 0));
+  }
+
+  node = llist_node_new((void *)(intptr_t)5);
+  printf("llist_queue_push(%p, node, 10) = %d\n", q, i = llist_queue_push(q, node, 10));
+  if (i) errors++;
+  else llist_node_free(node);
+
+  if (efd >= 0)
+  {
+    printf("read(%d) = %zd\n", efd, read(efd, &value, sizeof(value)));
+    if (value != 1) errors++;
+  }
+
+  node = llist_queue_pop(q, 0);
+  printf("llist_queue_pop(%p, 0) = %p payload=%ld\n", q, node, (long)(intptr_t)node->payload);
+  if ((intptr_t)node->payload != 1) errors++;
+  llist_node_free(node);
+
+  count = llist_queue_pop_batch(q, &batch, 8, 0);
+  printf("llist_queue_pop_batch(%p, &batch, 8, 0) = %zu\n", q, count);
+  if (count != 3 || (intptr_t)batch.tail->payload != 4) errors++;
+
+  node = llist_queue_pop(q, 10);
+  printf("llist_queue_pop(%p, 10) = %p\n", q, node);
+  if (node) errors++;
+
+  while ((node = batch.head))
+  {
+    llist_unlink(&batch, node);
+    llist_node_free(node);
+  }
+
+  printf("producer/consumer, %d messages\n", MESSAGES);
+  pthread_create(&p, NULL, producer, q);
+
+  for (expect = 1; (count = llist_queue_pop_batch(q, &batch, 64, -1)); )
+  {
+    while ((node = batch.head))
+    {
+      if ((intptr_t)node->payload != expect++) errors++;
+      llist_unlink(&batch, node);
+      llist_node_free(node);
+    }
+  }
+
+  pthread_join(p, NULL);
+  printf("received=%ld\n", (long)expect - 1);
+  if (expect - 1 != MESSAGES) errors++;
+
+  printf("llist_queue_push(%p, node, -1) after close = ", q);
+  node = llist_node_new(NULL);
+  printf("%d\n", i = llist_queue_push(q, node, -1));
+  if (i) errors++;
+  llist_node_free(node);
+
+  printf("llist_queue_free(%p)\n", q);
+  llist_queue_free(q);
+
+  printf("errors=%d\n", errors);
+
+  return errors ? 1 : 0;
+}
+
+void *producer(void *arg)
+{
+  llist_queue *q = (llist_queue *)arg;
+  intptr_t i;
+
+  for (i = 1; i <= MESSAGES; i++)
+    llist_queue_push(q, llist_node_new((void *)i), -1);
+
+  llist_queue_close(q);
+
+  return NULL;
+}
@@ -0,0 +1,200 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "llist_shm.h"
+
+typedef struct item item;
+
+struct item
+{
+  int id;
+  char name[16];
+};
+
+llist_node *new_node(int id);
+void free_node(llist_node *node);
+int cmp_node(llist_node *a, llist_node *b);
+size_t size_node(llist_node *node);
+int child(const char *name);
+void print_shm(llist_shm *shm);
+
+int main()
+{
+  llist *ll = NULL;
+  llist_shm *shm = NULL;
+  llist_shm *anon = NULL;
+  llist_shm *copy = NULL;
+  llist_shm_node *node = NULL;
+  item it = { 0, "" };
+  llist_node needle = { NULL, NULL, &it };
+  char name[64];
+  pid_t pid;
+  int status;
+  int errors = 0;
+  int i;
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  for (i = 1; i <= 10; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node(i));
+
+  sprintf(name, "/llist-test-%d", (int)getpid());
+  printf("llist_shm_create(\"%s\", 65536)\n", name);
+  shm = llist_shm_create(name, 65536);
+  printf("shm = %p\n", shm);
+  if (!shm) return 1;
+
+  printf("llist_shm_import(%p, %p, %p) = ", shm, ll, size_node);
+  printf("%d\n", llist_shm_import(shm, ll, size_node));
+  llist_free(ll);
+
+  it.id = 5;
+  llist_shm_lock(shm, 1);
+  node = llist_shm_find(shm, &needle, cmp_node);
+  printf("llist_shm_find(%p, &needle, %p) = %p\n", shm, cmp_node, node);
+  printf("llist_shm_remove_locked(%p, %p)\n", shm, node);
+  llist_shm_remove_locked(shm, node);
+  llist_shm_unlock(shm);
+
+  it.id = 4;
+  llist_shm_lock(shm, 1);
+  node = llist_shm_find(shm, &needle, cmp_node);
+  it.id = 99;
+  strcpy(it.name, "Howdy");
+  printf("llist_shm_add_locked(%p, %d, %p, &it, %zu)\n",
+         shm, llist_position_after, node, sizeof(item));
+  llist_shm_add_locked(shm, llist_position_after, node, &it, sizeof(item));
+  llist_shm_unlock(shm);
+
+  print_shm(shm);
+
+  fflush(stdout);
+
+  if (!(pid = fork())) exit(child(name));
+  waitpid(pid, &status, 0);
+  printf("child exit=%d\n", WEXITSTATUS(status));
+  if (WEXITSTATUS(status)) errors++;
+
+  printf("count after child=%zu\n", shm->header->count);
+  if (shm->header->count != 9) errors++;
+
+  printf("llist_shm_create(NULL, 4096)\n");
+  if ((anon = llist_shm_create(NULL, 4096)))
+  {
+    it.id = 7;
+    llist_shm_add(anon, llist_position_tail, NULL, &it, sizeof(item));
+
+    copy = llist_shm_attach(anon->fd);
+    printf("llist_shm_attach(%d) = %p, mapped at %p and %p\n",
+           anon->fd, copy, anon->header, copy->header);
+    node = llist_shm_head(copy);
+    if (!node || ((item *)llist_shm_payload(node))->id != 7) errors++;
+
+    llist_shm_close(copy);
+    llist_shm_close(anon);
+  }
+
+  llist_shm_close(shm);
+  llist_shm_unlink(name);
+
+  printf("errors=%d\n", errors);
+
+  return errors ? 1 : 0;
+}
+
+int child(const char *name)
+{
+  llist_shm *shm = NULL;
+  llist_shm_node *node = NULL;
+  int count = 0;
+
+  printf("child: llist_shm_open(\"%s\")\n", name);
+  if (!(shm = llist_shm_open(name))) return 1;
+
+  llist_shm_lock(shm, 1);
+  for (node = llist_shm_head(shm); node; node = llist_shm_next(shm, node))
+    count++;
+  node = llist_shm_tail(shm);
+
+  printf("child: count=%d tail id=%d\n",
+         count, ((item *)llist_shm_payload(node))->id);
+
+  printf("child: llist_shm_remove_locked(%p, %p)\n", shm, node);
+  llist_shm_remove_locked(shm, node);
+  llist_shm_unlock(shm);
+
+  llist_shm_close(shm);
+
+  return count == 10 ? 0 : 1;
+}
+
+llist_node *new_node(int id)
+{
+  item *it = NULL;
+
+  if (!(it = malloc(sizeof(item)))) return NULL;
+
+  it->id = id;
+  sprintf(it->name, "name%d", id);
+
+  return llist_node_new((void *)it);
+}
+
+void free_node(llist_node *node)
+{
+  if (!node) return;
+
+  free(node->payload);
+  llist_node_free(node);
+}
+
+int cmp_node(llist_node *a, llist_node *b)
+{
+  item *a_it, *b_it;
+
+  if (!a || !b) return 0;
+
+  a_it = (item *)a->payload;
+  b_it = (item *)b->payload;
+
+  if (!a_it || !b_it) return 0;
+
+  if (a_it->id < b_it->id) return -1;
+  if (a_it->id > b_it->id) return 1;
+  return 0;
+}
+
+size_t size_node(llist_node *node)
+{
+  return sizeof(item);
+}
+
+void print_shm(llist_shm *shm)
+{
+  llist_shm_node *node = NULL;
+  item *it;
+
+  if (!shm) return;
+
+  llist_shm_lock(shm, 0);
+
+  printf("LLIST_SHM:\n");
+  printf("  header=%p\n", shm->header);
+  printf("  size=%zu\n", shm->header->size);
+  printf("  count=%zu\n", shm->header->count);
+  printf("  brk=%zu\n", shm->header->brk);
+  printf("  NODES:\n");
+
+  for (node = llist_shm_head(shm); node; node = llist_shm_next(shm, node))
+  {
+    it = (item *)llist_shm_payload(node);
+    printf("    NODE (%zu)\n", (size_t)((char *)node - (char *)shm->header));
+    printf("      id=%d\n", it->id);
+    printf("      name=%s\n", it->name);
+  }
+
+  llist_shm_unlock(shm);
+}
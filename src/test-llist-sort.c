@@ -0,0 +1,242 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "llist_sort.h"
+
+typedef struct item item;
+
+struct item
+{
+  int id;
+  int seq;
+};
+
+llist_node *new_node(int id, int seq);
+void free_node(llist_node *node);
+int cmp_node(llist_node *a, llist_node *b);
+size_t size_node(llist_node *node);
+int write_node(FILE *fp, llist_node *node);
+llist_node *read_node(FILE *fp);
+int sink_node(llist_node *node, void *state);
+llist_node *gen_node(void *state);
+int check_sorted(llist *ll, int count, int unique);
+
+int _writes_left = -1;
+int _reads_left = -1;
+
+int main()
+{
+  llist *ll = NULL;
+  llist_sort_config config;
+  int generated = 0;
+  int sunk = 0;
+  int errors = 0;
+  int runs;
+  int i;
+
+  srand(1);
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+  for (i = 0; i < 20; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node(rand() % 8, i));
+
+  printf("llist_sort(%p)\n", ll);
+  llist_sort(ll);
+  errors += check_sorted(ll, 20, 0);
+
+  llist_free(ll);
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+  for (i = 0; i < 10000; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node(rand() % 1000, i));
+
+  memset(&config, 0, sizeof(llist_sort_config));
+  config.write_node = write_node;
+  config.read_node = read_node;
+  config.size_node = size_node;
+  config.budget = 500 * (sizeof(llist_node) + sizeof(item));
+  config.fan_in = 4;
+
+  runs = llist_sort_external(ll, &config);
+  printf("llist_sort_external(%p, &config) budget=%zu fan_in=%d = %d\n",
+         ll, config.budget, config.fan_in, runs);
+  if (runs != 20) errors++;
+  errors += check_sorted(ll, 10000, 0);
+
+  config.unique = 1;
+  runs = llist_sort_external(ll, &config);
+  printf("llist_sort_external(%p, &config) unique = %d\n", ll, runs);
+  errors += check_sorted(ll, 1000, 1);
+
+  llist_free(ll);
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+  llist_set_gen(ll, gen_node, &generated, 16);
+
+  config.unique = 0;
+  config.fan_in = 0;
+  config.sink_node = sink_node;
+  config.sink_state = &sunk;
+
+  runs = llist_sort_external(ll, &config);
+  printf("llist_sort_external(lazy %p, &config) sink = %d, generated=%d sunk=%d\n",
+         ll, runs, generated, sunk);
+  if (runs != 4 || generated != 2000 || sunk != 2000 || ll->head) errors++;
+
+  llist_free(ll);
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+  for (i = 0; i < 1000; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node(rand() % 1000, i));
+
+  memset(&config, 0, sizeof(llist_sort_config));
+  config.write_node = write_node;
+  config.read_node = read_node;
+  config.size_node = size_node;
+  config.budget = 50 * (sizeof(llist_node) + sizeof(item));
+  config.fan_in = 2;
+
+  _writes_left = 1150;
+  runs = llist_sort_external(ll, &config);
+  printf("llist_sort_external(%p, &config) failing writer = %d\n", ll, runs);
+  if (runs != -1) errors++;
+  _writes_left = -1;
+
+  for (i = 0; i < 1000; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node(rand() % 1000, i));
+
+  _reads_left = 500;
+  runs = llist_sort_external(ll, &config);
+  printf("llist_sort_external(%p, &config) failing reader = %d\n", ll, runs);
+  if (runs != -1) errors++;
+  _reads_left = -1;
+
+  llist_free(ll);
+
+  printf("errors=%d\n", errors);
+
+  return errors ? 1 : 0;
+}
+
+int check_sorted(llist *ll, int count, int unique)
+{
+  llist_node *node = NULL;
+  llist_node *last = NULL;
+  item *it, *prev;
+  int seen = 0;
+  int errors = 0;
+
+  for (node = llist_head(ll); node; node = llist_next(ll))
+  {
+    it = (item *)node->payload;
+    if (node->previous != last) errors++;
+    if (last)
+    {
+      prev = (item *)last->payload;
+      if (prev->id > it->id) errors++;
+      if (prev->id == it->id && (unique || prev->seq > it->seq)) errors++;
+    }
+    last = node;
+    seen++;
+  }
+
+  if (last != ll->tail) errors++;
+  if (seen != count) errors++;
+
+  printf("  count=%d out of order=%d\n", seen, errors);
+
+  return errors;
+}
+
+llist_node *new_node(int id, int seq)
+{
+  item *it = NULL;
+
+  if (!(it = malloc(sizeof(item)))) return NULL;
+
+  it->id = id;
+  it->seq = seq;
+
+  return llist_node_new((void *)it);
+}
+
+void free_node(llist_node *node)
+{
+  if (!node) return;
+
+  free(node->payload);
+  llist_node_free(node);
+}
+
+int cmp_node(llist_node *a, llist_node *b)
+{
+  item *a_it, *b_it;
+
+  if (!a || !b) return 0;
+
+  a_it = (item *)a->payload;
+  b_it = (item *)b->payload;
+
+  if (!a_it || !b_it) return 0;
+
+  if (a_it->id < b_it->id) return -1;
+  if (a_it->id > b_it->id) return 1;
+  return 0;
+}
+
+size_t size_node(llist_node *node)
+{
+  return sizeof(item);
+}
+
+int write_node(FILE *fp, llist_node *node)
+{
+  if (!_writes_left) return -1;
+  if (_writes_left > 0) _writes_left--;
+
+  return fwrite(node->payload, sizeof(item), 1, fp) == 1 ? 0 : -1;
+}
+
+llist_node *read_node(FILE *fp)
+{
+  item it;
+
+  if (!_reads_left) return NULL;
+  if (_reads_left > 0) _reads_left--;
+
+  if (fread(&it, sizeof(item), 1, fp) != 1) return NULL;
+
+  return new_node(it.id, it.seq);
+}
+
+int sink_node(llist_node *node, void *state)
+{
+  static int last = -1;
+  item *it = (item *)node->payload;
+
+  if (it->id < last) return 1;
+  last = it->id;
+
+  (*(int *)state)++;
+  free_node(node);
+
+  return 0;
+}
+
+llist_node *gen_node(void *state)
+{
+  int *generated = (int *)state;
+
+  if (*generated == 2000) return NULL;
+
+  return new_node(rand() % 1000, (*generated)++);
+}
@@ -0,0 +1,243 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "llist_view.h"
+
+typedef struct item item;
+
+struct item
+{
+  int id;
+  int score;
+};
+
+llist_node *new_node(int id, int score);
+void free_node(llist_node *node);
+int cmp_node(llist_node *a, llist_node *b);
+int cmp_score(llist_node *a, llist_node *b);
+int even_node(llist_node *node);
+llist_node *gen_node(void *state);
+int check_view(llist_view *view);
+void print_view(llist_view *view);
+
+int main()
+{
+  llist *ll = NULL;
+  llist_view *evens = NULL;
+  llist_view *ranked = NULL;
+  llist_view *top = NULL;
+  llist_node *node = NULL;
+  item it = { 0, 0 };
+  llist_node needle = { NULL, NULL, &it };
+  int generated = 0;
+  int errors = 0;
+  int i;
+
+  srand(1);
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+
+  for (i = 1; i <= 8; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node(i, rand() % 100));
+
+  printf("llist_view_new(%p, %p, NULL)\n", ll, even_node);
+  evens = llist_view_new(ll, even_node, NULL);
+  printf("llist_view_new(%p, NULL, %p)\n", ll, cmp_score);
+  ranked = llist_view_new(ll, NULL, cmp_score);
+  printf("llist_view_new(%p, %p, %p)\n", ll, even_node, cmp_score);
+  top = llist_view_new(ll, even_node, cmp_score);
+
+  print_view(evens);
+  print_view(ranked);
+
+  for (i = 9; i <= 200; i++)
+  {
+    node = new_node(i, rand() % 100);
+    switch (i % 4)
+    {
+      case 0: llist_add(ll, llist_position_head, NULL, node); break;
+      case 1: llist_add(ll, llist_position_tail, NULL, node); break;
+      case 2: llist_add(ll, llist_position_before, llist_head(ll), node); break;
+      case 3: llist_add(ll, llist_position_after, llist_head(ll), node); break;
+    }
+  }
+  printf("added 192 nodes at head, tail, before and after\n");
+  errors += check_view(evens) + check_view(ranked) + check_view(top);
+
+  for (i = 1; i <= 200; i += 3)
+  {
+    it.id = i;
+    llist_remove(ll, llist_find(ll, &needle));
+  }
+  it.id = 2;
+  node = llist_find(ll, &needle);
+  llist_unlink(ll, node);
+  free_node(node);
+  printf("removed 68 nodes\n");
+  errors += check_view(evens) + check_view(ranked) + check_view(top);
+
+  for (node = llist_head(ll); node; node = llist_next(ll))
+    if (((item *)node->payload)->id % 5 == 0)
+    {
+      ((item *)node->payload)->id++;
+      ((item *)node->payload)->score = 100;
+      llist_view_refresh(ll, node);
+    }
+  printf("llist_view_refresh() on changed nodes\n");
+  errors += check_view(evens) + check_view(ranked) + check_view(top);
+  if (((item *)llist_tail(ranked->ll)->payload)->score != 100) errors++;
+
+  printf("llist_compact(%p, 0) = %d\n", ll, llist_compact(ll, 0));
+  printf("llist_sort(%p)\n", ll);
+  llist_sort(ll);
+  errors += check_view(evens) + check_view(ranked) + check_view(top);
+
+  for (i = 0; i < 10; i++) llist_remove(ll, llist_head(ll));
+  printf("removed 10 relocated nodes\n");
+  errors += check_view(evens) + check_view(ranked) + check_view(top);
+
+  print_view(top);
+
+  llist_view_free(ranked);
+
+  printf("llist_free(%p)\n", ll);
+  llist_free(ll);
+  if (evens->base || evens->count || llist_head(evens->ll)) errors++;
+  llist_view_free(evens);
+  llist_view_free(top);
+
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_gen(ll, gen_node, &generated, 8);
+  evens = llist_view_new(ll, even_node, NULL);
+
+  for (node = llist_head(ll); node; node = llist_next(ll))
+    if (((item *)node->payload)->id == 20) break;
+  printf("lazy list, generated=%d view count=%zu\n", generated, evens->count);
+  if (generated != 24 || evens->count != 12) errors++;
+  errors += check_view(evens);
+
+  llist_view_free(evens);
+  llist_free(ll);
+
+  printf("errors=%d\n", errors);
+
+  return errors ? 1 : 0;
+}
+
+    /*
+     *  compares a view against the base list: same members, and either the
+     *  base order or sorted order
+     */
+
+int check_view(llist_view *view)
+{
+  llist_node *node = NULL;
+  llist_node *base = NULL;
+  llist_node *last = NULL;
+  size_t expected = 0;
+  size_t seen = 0;
+  int errors = 0;
+
+  for (base = view->base->head; base; base = base->next)
+    if (!view->filter_node || view->filter_node(base)) expected++;
+
+  base = view->base->head;
+  for (node = llist_head(view->ll); node; node = llist_next(view->ll))
+  {
+    if (node->payload != llist_view_base(node)->payload) errors++;
+    if (view->filter_node && !view->filter_node(node)) errors++;
+    if (view->cmp_node)
+    {
+      if (last && view->cmp_node(last, node) > 0) errors++;
+    }
+    else
+    {
+      while (base && base != llist_view_base(node)) base = base->next;
+      if (!base) errors++;
+    }
+    last = node;
+    seen++;
+  }
+
+  if (seen != expected || seen != view->count) errors++;
+
+  printf("  view %p count=%zu errors=%d\n", view, seen, errors);
+
+  return errors;
+}
+
+void print_view(llist_view *view)
+{
+  llist_node *node = NULL;
+  item *it;
+
+  printf("LLIST_VIEW %p:", view);
+  for (node = llist_head(view->ll); node; node = llist_next(view->ll))
+  {
+    it = (item *)node->payload;
+    printf(" %d/%d", it->id, it->score);
+  }
+  printf("\n");
+}
+
+llist_node *new_node(int id, int score)
+{
+  item *it = NULL;
+
+  if (!(it = malloc(sizeof(item)))) return NULL;
+
+  it->id = id;
+  it->score = score;
+
+  return llist_node_new((void *)it);
+}
+
+void free_node(llist_node *node)
+{
+  if (!node) return;
+
+  free(node->payload);
+  llist_node_free(node);
+}
+
+int cmp_node(llist_node *a, llist_node *b)
+{
+  item *a_it, *b_it;
+
+  if (!a || !b) return 0;
+
+  a_it = (item *)a->payload;
+  b_it = (item *)b->payload;
+
+  if (!a_it || !b_it) return 0;
+
+  if (a_it->id < b_it->id) return -1;
+  if (a_it->id > b_it->id) return 1;
+  return 0;
+}
+
+int cmp_score(llist_node *a, llist_node *b)
+{
+  item *a_it = (item *)a->payload;
+  item *b_it = (item *)b->payload;
+
+  return (a_it->score > b_it->score) - (a_it->score < b_it->score);
+}
+
+int even_node(llist_node *node)
+{
+  return !(((item *)node->payload)->id % 2);
+}
+
+llist_node *gen_node(void *state)
+{
+  int *generated = (int *)state;
+
+  (*generated)++;
+
+  return new_node(*generated, *generated);
+}
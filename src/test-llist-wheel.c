@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "llist_wheel.h"
+
+typedef struct item item;
+
+struct item
+{
+  int id;
+  unsigned long ticks;
+};
+
+void free_node(llist_node *node);
+void expire(llist *expired);
+
+llist_wheel *_w = NULL;
+int _expired = 0;
+int _late = 0;
+int _periodic = 0;
+
+int main()
+{
+  unsigned long ticks[] = { 0, 1, 63, 64, 65, 100, 4095, 4096, 5000,
+                            262143, 262144, 300000, 16777215, 16777216,
+                            20000000 };
+  int nticks = sizeof(ticks) / sizeof(ticks[0]);
+  llist_timer *cancelled = NULL;
+  llist_timer *timer = NULL;
+  item *it;
+  int errors = 0;
+  int i;
+
+  printf("llist_wheel_new()\n");
+  _w = llist_wheel_new();
+  printf("w = %p\n", _w);
+
+  printf("llist_wheel_set_free(%p, %p)\n", _w, free_node);
+  llist_wheel_set_free(_w, free_node);
+
+  printf("llist_wheel_set_expire(%p, %p)\n", _w, expire);
+  llist_wheel_set_expire(_w, expire);
+
+  llist_wheel_advance(_w, 12345);
+
+  for (i = 0; i < nticks; i++)
+  {
+    it = malloc(sizeof(item));
+    it->id = i;
+    it->ticks = _w->now + ticks[i];
+    timer = llist_wheel_schedule(_w, it, ticks[i]);
+    printf("llist_wheel_schedule(%p, %p, %lu) = %p\n", _w, it, ticks[i], timer);
+    if (i == 5) cancelled = timer;
+  }
+
+  printf("llist_compact(%p, 0)\n", timer->bucket);
+  if (llist_compact(timer->bucket, 0) || timer->bucket->blocks) errors++;
+
+  printf("llist_wheel_cancel(%p, %p)\n", _w, cancelled);
+  llist_wheel_cancel(_w, cancelled);
+
+  it = malloc(sizeof(item));
+  it->id = -1;
+  it->ticks = _w->now + 1000;
+  printf("llist_wheel_schedule(%p, %p, 1000) periodic\n", _w, it);
+  llist_wheel_schedule(_w, it, 1000);
+
+  printf("pending=%lu\n", _w->pending);
+
+  while (_w->pending > 1) llist_wheel_advance(_w, 1);
+
+  printf("now=%lu expired=%d late=%d periodic=%d pending=%lu\n",
+         _w->now, _expired, _late, _periodic, _w->pending);
+
+  if (_expired != nticks - 1 || _late) errors++;
+
+  printf("llist_wheel_advance(%p, 5000)\n", _w);
+  llist_wheel_advance(_w, 5000);
+  printf("periodic=%d pending=%lu\n", _periodic, _w->pending);
+
+  printf("llist_wheel_free(%p)\n", _w);
+  llist_wheel_free(_w);
+
+  printf("errors=%d\n", errors);
+
+  return errors ? 1 : 0;
+}
+
+void free_node(llist_node *node)
+{
+  if (!node) return;
+
+  free(node->payload);
+  llist_node_free(node);
+}
+
+void expire(llist *expired)
+{
+  llist_node *node, *next;
+  item *it;
+
+  for (node = llist_head(expired); node; node = next)
+  {
+    next = node->next;
+    it = (item *)node->payload;
+
+    if (it->ticks != _w->now - 1) _late++;
+
+    if (it->id < 0)
+    {
+      _periodic++;
+      it->ticks = _w->now + 1000;
+      llist_wheel_reschedule(_w, (llist_timer *)node, 1000);
+      continue;
+    }
+
+    printf("expire: id=%d ticks=%lu now=%lu\n", it->id, it->ticks, _w->now);
+    _expired++;
+  }
+}
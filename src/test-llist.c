@@ -2,6 +2,8 @@
 #include <stdio.h> 
 #include <string.h> 
 
+#include <stdint.h>
+
 #include "llist.h"
 
 typedef struct item item;
@@ -16,17 +18,25 @@ llist_node *new_node(void);
 llist_node *dup_node(llist_node *node);
 void free_node(llist_node *node);
 int cmp_node(llist_node *a, llist_node *b);
+uint64_t key_node(llist_node *node);
+llist_node *gen_node(void *state);
+void move_node(llist_node *from, llist_node *to);
 void print_llist(llist *ll);
 
 int _id = 0;
+int _moved = 0;
+int _compared = 0;
 
 int main() 
 { 
   llist *ll = NULL;
   llist *ll_dup = NULL;
   llist_node *node = NULL;
+  llist_node_cache_stats stats;
   item it = { 0, NULL };
   llist_node needle = { NULL, NULL, &it };
+  int remaining;
+  int calls;
   int i;
 
   printf("llist_new()\n");
@@ -83,6 +93,11 @@ int main()
 
   print_llist(ll);
 
+  for (i = 0, node = ll->head; node && node->next; node = node->next)
+    if (node->next->previous != node) i++;
+  printf("broken previous links=%d\n", i);
+  if (i) return 1;
+
   node = llist_head(ll);
   it.id = -1;
   it.name = "BOOM1";
@@ -110,6 +125,119 @@ int main()
   printf("llist_free(%p)\n", ll_dup);
   llist_free(ll_dup);
 
+  _id = 0;
+  remaining = 1000;
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+
+  printf("llist_set_gen(%p, %p, %p, 4)\n", ll, gen_node, &remaining);
+  llist_set_gen(ll, gen_node, &remaining, 4);
+
+  it.id = 6;
+  printf("llist_find(%p, &needle)\n", ll);
+  node = llist_find(ll, &needle);
+  printf("node=%p: payload(it)->id=%d, generated=%d\n",
+         node, ((item *)node->payload)->id, 1000 - remaining);
+
+  print_llist(ll);
+
+  printf("llist_tail(%p)\n", ll);
+  node = llist_tail(ll);
+  printf("node=%p: payload(it)->id=%d, generated=%d\n",
+         node, ((item *)node->payload)->id, 1000 - remaining);
+
+  for (node = llist_head(ll); node; )
+  {
+    node = node->next;
+    if (node && node->previous) llist_remove(ll, node->previous);
+    if (node) node = node->next;
+  }
+
+  printf("llist_set_move(%p, %p)\n", ll, move_node);
+  llist_set_move(ll, move_node);
+
+  printf("llist_compact(%p, 1)\n", ll);
+  for (calls = 1; !llist_compact(ll, 1); calls++);
+  printf("calls=%d moved=%d\n", calls, _moved);
+
+  for (i = 0, calls = 1, node = ll->head; node && node->next; node = node->next)
+  {
+    if (cmp_node(node, node->next) >= 0) i++;
+    if (node->next != node + 1) calls++;
+  }
+  printf("out of order=%d contiguous runs=%d\n", i, calls);
+
+  it.id = 500;
+  node = llist_find(ll, &needle);
+  printf("llist_remove(%p, %p)\n", ll, node);
+  llist_remove(ll, node);
+
+  printf("llist_free(%p)\n", ll);
+  llist_free(ll);
+
+  _id = 0;
+  _moved = 0;
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_move(ll, move_node);
+  for (i = 0; i < 20000; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node());
+
+  printf("llist_compact(%p, 1) = %d\n", ll, llist_compact(ll, 1));
+
+  node = llist_head(ll);
+  printf("llist_unlink(%p, %p)\n", ll, node);
+  llist_unlink(ll, node);
+  printf("llist_add(%p, %d, NULL, %p)\n", ll, llist_position_tail, node);
+  llist_add(ll, llist_position_tail, NULL, node);
+
+  printf("llist_compact(%p, 0) = %d\n", ll, llist_compact(ll, 0));
+  printf("moved=%d\n", _moved);
+  llist_node_cache_purge();
+  if (_moved != 20000) return 1;
+
+  printf("llist_free(%p)\n", ll);
+  llist_free(ll);
+
+  _id = 0;
+  ll = llist_new();
+  llist_set_free(ll, free_node);
+  llist_set_cmp(ll, cmp_node);
+  for (i = 0; i < 50; i++)
+    llist_add(ll, llist_position_tail, NULL, new_node());
+
+  printf("llist_set_key(%p, %p)\n", ll, key_node);
+  llist_set_key(ll, key_node);
+  for (i = 0; i < 50; i++)
+    llist_add(ll, llist_position_head, NULL, new_node());
+
+  _compared = 0;
+  it.id = 25;
+  node = llist_find(ll, &needle);
+  printf("llist_find(%p, &needle) id=%d, node=%p, compared=%d\n",
+         ll, it.id, node, _compared);
+
+  _compared = 0;
+  it.id = 75;
+  node = llist_find(ll, &needle);
+  printf("llist_find(%p, &needle) id=%d, node=%p, compared=%d\n",
+         ll, it.id, node, _compared);
+
+  _compared = 0;
+  it.id = 101;
+  node = llist_find(ll, &needle);
+  printf("llist_find(%p, &needle) id=%d, node=%p, compared=%d\n",
+         ll, it.id, node, _compared);
+
+  printf("llist_free(%p)\n", ll);
+  llist_free(ll);
+
+  printf("llist_node_cache_stats_get(%p)\n", &stats);
+  llist_node_cache_stats_get(&stats);
+  printf("  allocs=%lu hits=%lu frees=%lu\n",
+         stats.allocs, stats.hits, stats.frees);
+
   return 0; 
 } 
 
@@ -166,7 +294,7 @@ void free_node(llist_node *node)
     free(it);
   }
 
-  free(node);
+  llist_node_free(node);
 }
 
 int cmp_node(llist_node *a, llist_node *b)
@@ -175,6 +303,8 @@ int cmp_node(llist_node *a, llist_node *b)
 
   if (!a || !b) return 0;
 
+  _compared++;
+
   a_it = (item *)a->payload;
   b_it = (item *)b->payload;
 
@@ -185,6 +315,27 @@ int cmp_node(llist_node *a, llist_node *b)
   return 0;
 }
 
+uint64_t key_node(llist_node *node)
+{
+  return node->payload ? ((item *)node->payload)->id : 0;
+}
+
+llist_node *gen_node(void *state)
+{
+  int *remaining = (int *)state;
+
+  if (!*remaining) return NULL;
+
+  (*remaining)--;
+
+  return new_node();
+}
+
+void move_node(llist_node *from, llist_node *to)
+{
+  _moved++;
+}
+
 void print_llist(llist *ll)
 {
   llist_node *node = NULL;